@@ -0,0 +1,80 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+namespace Benchmarks
+{
+// Define a benchmark object roughly the size of a typical game entity component
+struct CParticle
+{
+	float position[3] = {0.f, 0.f, 0.f};
+	float velocity[3] = {1.f, 1.f, 1.f};
+	uint32_t lifetime = 0u;
+};
+
+constexpr uint32_t SEED = 42u;
+
+/** Shuffled slot indices, so access patterns are not trivially predictable. */
+inline std::vector<size_t> MakeShuffledIndices(const size_t count)
+{
+	std::vector<size_t> indices(count);
+	std::iota(indices.begin(), indices.end(), 0);
+	std::shuffle(indices.begin(), indices.end(), std::mt19937(SEED));
+	return indices;
+}
+
+/**
+ * @brief Collects per-operation latencies and reports them as benchmark counters.
+ *
+ * Google Benchmark only reports means, which hide the rare long scans we care about.
+ * Time single operations with `Start()` / `Stop()` and call `Report()` after the loop
+ * to publish `p50`, `p99`, `p999` and `max` (in nanoseconds).
+ */
+class CLatencyRecorder
+{
+public:
+	using TClock = std::chrono::steady_clock;
+
+	explicit CLatencyRecorder(const size_t expected_samples)
+	{
+		samples.reserve(expected_samples);
+	}
+
+	void Start() noexcept
+	{
+		startTime = TClock::now();
+	}
+
+	void Stop()
+	{
+		const auto elapsed = TClock::now() - startTime;
+		samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+	}
+
+	void Report(benchmark::State& state)
+	{
+		if (samples.empty())
+			return;
+		state.counters["p50_ns"] = Percentile(0.5);
+		state.counters["p99_ns"] = Percentile(0.99);
+		state.counters["p999_ns"] = Percentile(0.999);
+		state.counters["max_ns"] = static_cast<double>(*std::ranges::max_element(samples));
+	}
+
+private:
+	std::vector<int64_t> samples;
+	TClock::time_point startTime;
+
+	double Percentile(const double quantile)
+	{
+		const auto rank = static_cast<size_t>(quantile * static_cast<double>(samples.size() - 1));
+		std::ranges::nth_element(samples, samples.begin() + static_cast<std::ptrdiff_t>(rank));
+		return static_cast<double>(samples[rank]);
+	}
+};
+}
@@ -0,0 +1,144 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "BenchmarkCommon.hpp"
+#include "CObjectPool.hpp"
+
+using namespace ObjectPool;
+
+namespace Benchmarks::Fragmentation
+{
+/**
+ * Adversarial occupancy patterns for the free-slot search.
+ *
+ * - `RANDOM_99` — 99% of the slots used, holes spread uniformly.
+ * - `STRIPED` — every 100th slot free, the search always has to cross 99 used slots.
+ * - `CLUSTERED` — all holes packed at the end of the pool, so wrapping around
+ *   means scanning the complete used prefix.
+ */
+enum class EPattern : uint8_t
+{
+	RANDOM_99,
+	STRIPED,
+	CLUSTERED
+};
+
+constexpr size_t FREE_EVERY_NTH = 100;
+
+template <typename TPool>
+void FillPattern(TPool& pool, const EPattern pattern)
+{
+	const size_t poolSize = pool.Size();
+	const size_t freeSlots = poolSize / FREE_EVERY_NTH;
+	switch (pattern)
+	{
+	case EPattern::RANDOM_99:
+		{
+			const auto indices = MakeShuffledIndices(poolSize);
+			for (size_t idx = freeSlots; idx < poolSize; ++idx)
+				(void)pool.Use(indices[idx]);
+			break;
+		}
+	case EPattern::STRIPED:
+		for (size_t pos = 0; pos < poolSize; ++pos)
+			if (pos % FREE_EVERY_NTH != FREE_EVERY_NTH - 1)
+				(void)pool.Use(pos);
+		break;
+	case EPattern::CLUSTERED:
+		for (size_t pos = 0; pos < poolSize - freeSlots; ++pos)
+			(void)pool.Use(pos);
+		break;
+	}
+}
+
+// Times each UseNext individually and releases the slot again (untimed),
+// so the occupancy pattern stays the same for the whole run.
+void BM_UseNext_Latency(benchmark::State& state, const EPattern pattern)
+{
+	CObjectPool<CParticle> pool(static_cast<size_t>(state.range(0)));
+	FillPattern(pool, pattern);
+	CLatencyRecorder recorder(1 << 20);
+
+	size_t idx;
+	for (auto _ : state)
+	{
+		recorder.Start();
+		auto result = pool.UseNext(idx);
+		recorder.Stop();
+		benchmark::DoNotOptimize(result);
+		(void)pool.UnUse(idx);
+	}
+	recorder.Report(state);
+}
+
+BENCHMARK_CAPTURE(BM_UseNext_Latency, random_99, EPattern::RANDOM_99)->Range(1 << 12, 1 << 20);
+BENCHMARK_CAPTURE(BM_UseNext_Latency, striped, EPattern::STRIPED)->Range(1 << 12, 1 << 20);
+BENCHMARK_CAPTURE(BM_UseNext_Latency, clustered, EPattern::CLUSTERED)->Range(1 << 12, 1 << 20);
+
+// Same as above, but the released slot is picked at random, so the holes wander through the pool.
+void BM_UseNext_Latency_RandomRelease(benchmark::State& state, const EPattern pattern)
+{
+	const auto poolSize = static_cast<size_t>(state.range(0));
+	CObjectPool<CParticle> pool(poolSize);
+	FillPattern(pool, pattern);
+	CLatencyRecorder recorder(1 << 20);
+	std::mt19937 generator(SEED);
+	std::uniform_int_distribution<size_t> distribution(0, poolSize - 1);
+
+	size_t idx;
+	for (auto _ : state)
+	{
+		recorder.Start();
+		auto result = pool.UseNext(idx);
+		recorder.Stop();
+		benchmark::DoNotOptimize(result);
+
+		state.PauseTiming();
+		// release a random used slot to keep the occupancy constant
+		size_t victim = distribution(generator);
+		while (!pool.IsInUse(victim))
+			victim = distribution(generator);
+		(void)pool.UnUse(victim);
+		state.ResumeTiming();
+	}
+	recorder.Report(state);
+}
+
+BENCHMARK_CAPTURE(BM_UseNext_Latency_RandomRelease, random_99, EPattern::RANDOM_99)->Range(1 << 12, 1 << 20);
+BENCHMARK_CAPTURE(BM_UseNext_Latency_RandomRelease, clustered, EPattern::CLUSTERED)->Range(1 << 12, 1 << 20);
+
+// Random release on a 99% full pool for every allocation policy.
+template <EAllocPolicy ALLOC_POLICY>
+void BM_UseNext_Latency_Policy(benchmark::State& state)
+{
+	const auto poolSize = static_cast<size_t>(state.range(0));
+	CObjectPool<CParticle, CNoPoolStats, CNoPoolObserver, ALLOC_POLICY> pool(poolSize);
+	FillPattern(pool, EPattern::RANDOM_99);
+	CLatencyRecorder recorder(1 << 20);
+	std::mt19937 generator(SEED);
+	std::uniform_int_distribution<size_t> distribution(0, poolSize - 1);
+
+	size_t idx;
+	for (auto _ : state)
+	{
+		recorder.Start();
+		auto result = pool.UseNext(idx);
+		recorder.Stop();
+		benchmark::DoNotOptimize(result);
+
+		state.PauseTiming();
+		size_t victim = distribution(generator);
+		while (!pool.IsInUse(victim))
+			victim = distribution(generator);
+		(void)pool.UnUse(victim);
+		state.ResumeTiming();
+	}
+	recorder.Report(state);
+}
+
+BENCHMARK_TEMPLATE(BM_UseNext_Latency_Policy, EAllocPolicy::ROUND_ROBIN)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_UseNext_Latency_Policy, EAllocPolicy::LOWEST_FREE)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_UseNext_Latency_Policy, EAllocPolicy::MOST_RECENTLY_FREED)->Range(1 << 12, 1 << 20);
+}
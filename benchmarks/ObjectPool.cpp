@@ -0,0 +1,353 @@
+#include <cstdint>
+#include <execution>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#ifdef OBJECT_POOL_BENCH_BOOST
+#include <boost/pool/object_pool.hpp>
+#endif
+
+#include "BenchmarkCommon.hpp"
+#include "CObjectPool.hpp"
+
+using namespace ObjectPool;
+
+namespace Benchmarks::ObjectPool
+{
+constexpr int64_t MIN_POOL_SIZE = 1 << 10;
+constexpr int64_t MAX_POOL_SIZE = 1 << 16;
+
+/** Marks `occupancy` percent of the slots as used, spread randomly across the pool. */
+void FillRandomly(CObjectPool<CParticle>& pool, const int64_t occupancy)
+{
+	const auto indices = MakeShuffledIndices(pool.Size());
+	const size_t count = pool.Size() * static_cast<size_t>(occupancy) / 100;
+	for (size_t idx = 0; idx < count; ++idx)
+		(void)pool.Use(indices[idx]);
+}
+
+// ------------------ UseNext / UnUse churn ------------------
+
+// Acquire half of the pool, then keep releasing the oldest and acquiring a new object.
+void BM_Churn_ObjectPool(benchmark::State& state)
+{
+	const auto poolSize = static_cast<size_t>(state.range(0));
+	CObjectPool<CParticle> pool(poolSize);
+	std::vector<size_t> live(poolSize / 2);
+	for (auto& idx : live)
+		(void)pool.UseNext(idx);
+
+	size_t oldest = 0;
+	for (auto _ : state)
+	{
+		(void)pool.UnUse(live[oldest]);
+		auto result = pool.UseNext(live[oldest]);
+		benchmark::DoNotOptimize(result);
+		oldest = (oldest + 1) % live.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Churn_ObjectPool)->Range(MIN_POOL_SIZE, MAX_POOL_SIZE);
+
+void BM_Churn_NewDelete(benchmark::State& state)
+{
+	const auto poolSize = static_cast<size_t>(state.range(0));
+	std::vector<CParticle*> live(poolSize / 2);
+	for (auto& pObject : live)
+		pObject = new CParticle();
+
+	size_t oldest = 0;
+	for (auto _ : state)
+	{
+		delete live[oldest];
+		live[oldest] = new CParticle();
+		benchmark::DoNotOptimize(live[oldest]);
+		oldest = (oldest + 1) % live.size();
+	}
+	for (const auto* pObject : live)
+		delete pObject;
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Churn_NewDelete)->Range(MIN_POOL_SIZE, MAX_POOL_SIZE);
+
+void BM_Churn_PmrPool(benchmark::State& state)
+{
+	const auto poolSize = static_cast<size_t>(state.range(0));
+	std::pmr::unsynchronized_pool_resource resource;
+	std::pmr::polymorphic_allocator<CParticle> allocator(&resource);
+	std::vector<CParticle*> live(poolSize / 2);
+	for (auto& pObject : live)
+		pObject = allocator.new_object<CParticle>();
+
+	size_t oldest = 0;
+	for (auto _ : state)
+	{
+		allocator.delete_object(live[oldest]);
+		live[oldest] = allocator.new_object<CParticle>();
+		benchmark::DoNotOptimize(live[oldest]);
+		oldest = (oldest + 1) % live.size();
+	}
+	for (auto* pObject : live)
+		allocator.delete_object(pObject);
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Churn_PmrPool)->Range(MIN_POOL_SIZE, MAX_POOL_SIZE);
+
+#ifdef OBJECT_POOL_BENCH_BOOST
+void BM_Churn_BoostPool(benchmark::State& state)
+{
+	const auto poolSize = static_cast<size_t>(state.range(0));
+	boost::object_pool<CParticle> pool(poolSize);
+	std::vector<CParticle*> live(poolSize / 2);
+	for (auto& pObject : live)
+		pObject = pool.construct();
+
+	size_t oldest = 0;
+	for (auto _ : state)
+	{
+		pool.destroy(live[oldest]);
+		live[oldest] = pool.construct();
+		benchmark::DoNotOptimize(live[oldest]);
+		oldest = (oldest + 1) % live.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Churn_BoostPool)->Range(MIN_POOL_SIZE, MAX_POOL_SIZE);
+#endif
+
+// ------------------ Iteration at various occupancy levels ------------------
+
+void BM_Iterate_ObjectPool(benchmark::State& state)
+{
+	CObjectPool<CParticle> pool(MAX_POOL_SIZE);
+	FillRandomly(pool, state.range(0));
+
+	for (auto _ : state)
+	{
+		for (auto& particle : pool)
+			particle.position[0] += particle.velocity[0];
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(pool.ObjectsInUse()));
+}
+
+BENCHMARK(BM_Iterate_ObjectPool)->Arg(1)->Arg(10)->Arg(50)->Arg(90)->Arg(99)->Arg(100);
+
+void BM_IterateRuns_ObjectPool(benchmark::State& state)
+{
+	CObjectPool<CParticle> pool(MAX_POOL_SIZE);
+	FillRandomly(pool, state.range(0));
+
+	for (auto _ : state)
+	{
+		for (const std::span<CParticle> run : pool.Runs())
+		{
+			for (auto& particle : run)
+				particle.position[0] += particle.velocity[0];
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(pool.ObjectsInUse()));
+}
+
+BENCHMARK(BM_IterateRuns_ObjectPool)->Arg(1)->Arg(10)->Arg(50)->Arg(90)->Arg(99)->Arg(100);
+
+// Same occupancy as BM_Iterate_ObjectPool, but the active objects were packed into a dense prefix.
+void BM_Iterate_ObjectPool_Compacted(benchmark::State& state)
+{
+	CObjectPool<CParticle> pool(MAX_POOL_SIZE);
+	FillRandomly(pool, state.range(0));
+	(void)pool.Compact([](size_t, size_t) {});
+
+	for (auto _ : state)
+	{
+		for (auto& particle : pool)
+			particle.position[0] += particle.velocity[0];
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(pool.ObjectsInUse()));
+}
+
+BENCHMARK(BM_Iterate_ObjectPool_Compacted)->Arg(1)->Arg(10)->Arg(50)->Arg(90)->Arg(99)->Arg(100);
+
+void BM_ForEachActive_Parallel(benchmark::State& state)
+{
+	CObjectPool<CParticle> pool(MAX_POOL_SIZE * 16);
+	FillRandomly(pool, state.range(0));
+
+	for (auto _ : state)
+	{
+		pool.ForEachActive(std::execution::par, [](CParticle& particle)
+		{
+			particle.position[0] += particle.velocity[0];
+		});
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(pool.ObjectsInUse()));
+}
+
+BENCHMARK(BM_ForEachActive_Parallel)->Arg(10)->Arg(50)->Arg(90)->Arg(100)->UseRealTime();
+
+// Baseline: the same live objects allocated individually and tracked in a vector of pointers.
+void BM_Iterate_NewDelete(benchmark::State& state)
+{
+	const size_t count = MAX_POOL_SIZE * static_cast<size_t>(state.range(0)) / 100;
+	std::vector<std::unique_ptr<CParticle>> live(count);
+	for (auto& pObject : live)
+		pObject = std::make_unique<CParticle>();
+
+	for (auto _ : state)
+	{
+		for (const auto& pParticle : live)
+			pParticle->position[0] += pParticle->velocity[0];
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+BENCHMARK(BM_Iterate_NewDelete)->Arg(1)->Arg(10)->Arg(50)->Arg(90)->Arg(100);
+
+// ------------------ Get random access ------------------
+
+void BM_Get_Random(benchmark::State& state)
+{
+	const auto poolSize = static_cast<size_t>(state.range(0));
+	CObjectPool<CParticle> pool(poolSize);
+	FillRandomly(pool, 50);
+	const auto indices = MakeShuffledIndices(poolSize);
+
+	size_t pos = 0;
+	for (auto _ : state)
+	{
+		auto result = pool.Get(indices[pos]);
+		benchmark::DoNotOptimize(result);
+		pos = (pos + 1) % poolSize;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Get_Random)->Range(MIN_POOL_SIZE, MAX_POOL_SIZE);
+
+void BM_OperatorBrackets_Random(benchmark::State& state)
+{
+	const auto poolSize = static_cast<size_t>(state.range(0));
+	CObjectPool<CParticle> pool(poolSize);
+	const auto indices = MakeShuffledIndices(poolSize);
+
+	size_t pos = 0;
+	for (auto _ : state)
+	{
+		CParticle* pParticle = pool[indices[pos]];
+		benchmark::DoNotOptimize(pParticle);
+		pos = (pos + 1) % poolSize;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_OperatorBrackets_Random)->Range(MIN_POOL_SIZE, MAX_POOL_SIZE);
+
+// ------------------ Snapshot / Restore ------------------
+
+// Save the pool every iteration after `range(0)` percent of the objects changed, as rollback netcode does per frame.
+// The changes are clustered in the lowest slots, like the objects of one system updated together.
+void BM_Snapshot_Full(benchmark::State& state)
+{
+	CObjectPool<CParticle> pool(MAX_POOL_SIZE);
+	FillRandomly(pool, 50);
+	const size_t changed = pool.Size() * static_cast<size_t>(state.range(0)) / 100;
+	auto snapshot = pool.Snapshot();
+
+	for (auto _ : state)
+	{
+		for (size_t idx = 0; idx < changed; ++idx)
+			pool[idx]->position[0] += 1.0f;
+		pool.Snapshot(snapshot);
+		benchmark::ClobberMemory();
+	}
+	state.SetBytesProcessed(state.iterations() * MAX_POOL_SIZE * static_cast<int64_t>(sizeof(CParticle)));
+}
+
+BENCHMARK(BM_Snapshot_Full)->Arg(1)->Arg(10)->Arg(100);
+
+void BM_Snapshot_Delta(benchmark::State& state)
+{
+	CObjectPool<CParticle> pool(MAX_POOL_SIZE);
+	FillRandomly(pool, 50);
+	const size_t changed = pool.Size() * static_cast<size_t>(state.range(0)) / 100;
+	auto snapshot = pool.Snapshot();
+
+	for (auto _ : state)
+	{
+		for (size_t idx = 0; idx < changed; ++idx)
+			pool[idx]->position[0] += 1.0f;
+		benchmark::DoNotOptimize(pool.SnapshotDelta(snapshot));
+	}
+	state.SetBytesProcessed(state.iterations() * MAX_POOL_SIZE * static_cast<int64_t>(sizeof(CParticle)));
+}
+
+BENCHMARK(BM_Snapshot_Delta)->Arg(1)->Arg(10)->Arg(100);
+
+// ------------------ Startup ------------------
+
+void BM_Startup_ObjectPool(benchmark::State& state)
+{
+	const auto poolSize = static_cast<size_t>(state.range(0));
+	for (auto _ : state)
+	{
+		CObjectPool<CParticle> pool(poolSize);
+		benchmark::DoNotOptimize(pool[0]);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Startup_ObjectPool)->Range(MIN_POOL_SIZE, MAX_POOL_SIZE);
+
+void BM_Startup_NewDelete(benchmark::State& state)
+{
+	const auto poolSize = static_cast<size_t>(state.range(0));
+	for (auto _ : state)
+	{
+		const auto pObjects = std::make_unique<CParticle[]>(poolSize);
+		benchmark::DoNotOptimize(pObjects.get());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Startup_NewDelete)->Range(MIN_POOL_SIZE, MAX_POOL_SIZE);
+
+void BM_Startup_PmrPool(benchmark::State& state)
+{
+	const auto poolSize = static_cast<size_t>(state.range(0));
+	for (auto _ : state)
+	{
+		std::pmr::unsynchronized_pool_resource resource;
+		std::pmr::vector<CParticle> objects(poolSize, &resource);
+		benchmark::DoNotOptimize(objects.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Startup_PmrPool)->Range(MIN_POOL_SIZE, MAX_POOL_SIZE);
+
+#ifdef OBJECT_POOL_BENCH_BOOST
+void BM_Startup_BoostPool(benchmark::State& state)
+{
+	const auto poolSize = static_cast<size_t>(state.range(0));
+	for (auto _ : state)
+	{
+		boost::object_pool<CParticle> pool(poolSize);
+		benchmark::DoNotOptimize(pool.construct());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Startup_BoostPool)->Range(MIN_POOL_SIZE, MAX_POOL_SIZE);
+#endif
+}
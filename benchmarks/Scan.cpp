@@ -0,0 +1,83 @@
+#include <cstdint>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "CObjectPool.hpp"
+
+using namespace ObjectPool;
+
+namespace Benchmarks::Scan
+{
+// Worst case for the free-slot search: the only free slot sits right before the start,
+// so every call inspects all flags. `items_per_second` is the number of flags per second.
+std::vector<uint8_t> MakeWorstCaseFlags(const size_t count)
+{
+	std::vector<uint8_t> flags(count, Detail::FLAG_USED);
+	flags[count / 2 - 1] = Detail::FLAG_FREE;
+	return flags;
+}
+
+// Reference: the search loop used before the scan was split into two linear segments
+size_t FindFreeModulo(const uint8_t* flags, const size_t size, const size_t start)
+{
+	for (size_t pos = start, idx = 0; idx < size; ++pos, pos %= size, ++idx)
+	{
+		if (flags[pos] == Detail::FLAG_FREE)
+			return pos;
+	}
+	return size;
+}
+
+void BM_Scan_ModuloLoop(benchmark::State& state)
+{
+	const auto flagCount = static_cast<size_t>(state.range(0));
+	const auto flags = MakeWorstCaseFlags(flagCount);
+	auto start = flagCount / 2;
+	benchmark::DoNotOptimize(start);
+
+	for (auto _ : state)
+	{
+		auto pos = FindFreeModulo(flags.data(), flagCount, start);
+		benchmark::DoNotOptimize(pos);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Scan_ModuloLoop)->Range(1 << 8, 1 << 20);
+
+void BM_Scan_WrappedScalar(benchmark::State& state)
+{
+	const auto flagCount = static_cast<size_t>(state.range(0));
+	const auto flags = MakeWorstCaseFlags(flagCount);
+	auto start = flagCount / 2;
+	benchmark::DoNotOptimize(start);
+
+	for (auto _ : state)
+	{
+		size_t pos = Detail::FindFlagScalar(flags.data(), start, flagCount, Detail::FLAG_FREE);
+		if (pos == flagCount)
+			pos = Detail::FindFlagScalar(flags.data(), 0, start, Detail::FLAG_FREE);
+		benchmark::DoNotOptimize(pos);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Scan_WrappedScalar)->Range(1 << 8, 1 << 20);
+
+void BM_Scan_Wrapped(benchmark::State& state)
+{
+	const auto flagCount = static_cast<size_t>(state.range(0));
+	const auto flags = MakeWorstCaseFlags(flagCount);
+	auto start = flagCount / 2;
+	benchmark::DoNotOptimize(start);
+
+	for (auto _ : state)
+	{
+		auto pos = Detail::FindFlagWrapped(flags.data(), flagCount, start, Detail::FLAG_FREE);
+		benchmark::DoNotOptimize(pos);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Scan_Wrapped)->Range(1 << 8, 1 << 20);
+}
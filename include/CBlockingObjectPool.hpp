@@ -0,0 +1,411 @@
+// -----------------------------------------------------------------------------
+// CBlockingObjectPool.hpp
+// Thread-safe object pool whose acquire can wait for a free slot, turning the
+// pool into a bounded-concurrency limiter for expensive resources.
+// Author: Daniel Contu (Migos) — https://github.com/AbsintheScripting
+// -----------------------------------------------------------------------------
+#pragma once
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <expected>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+#include "CObjectPool.hpp"
+
+namespace ObjectPool
+{
+/**
+ * @brief Executor resuming a coroutine directly on the calling (releasing) thread.
+ *
+ * The coroutine runs inside the `noexcept` `UnUse`, so its promise must not rethrow
+ * from `unhandled_exception`, otherwise an escaping exception calls `std::terminate`.
+ * Use an executor which schedules the coroutine elsewhere for such promises.
+ */
+struct CInlineExecutor
+{
+	void operator()(const std::coroutine_handle<> handle) const noexcept
+	{
+		handle.resume();
+	}
+};
+
+/**
+ * @brief Callable which schedules a suspended coroutine, e.g. by posting it to a thread pool.
+ *
+ * It is moved and invoked by the `noexcept` `UnUse`, so both must not throw.
+ */
+template <typename TExecutor>
+concept coroutine_executor = std::is_nothrow_move_constructible_v<TExecutor>
+	&& std::is_nothrow_invocable_v<TExecutor&, std::coroutine_handle<>>;
+
+/**
+ * @class CBlockingObjectPool
+ * @brief Thread-safe wrapper around `CObjectPool` with blocking and timed acquire.
+ *
+ * Every operation locks an internal mutex. If the pool is full, `UseNextWait` parks
+ * the caller on a condition variable until a slot is released, `UseNextFor` and
+ * `UseNextUntil` give up after the timeout with `EPoolError::FULL`. Each `UnUse`
+ * wakes exactly one waiter, so no CPU is burnt on retries.
+ *
+ * Coroutines use `co_await AcquireAsync(id)` instead, which doesn't block a thread.
+ * Suspended coroutines are queued in FIFO order and take precedence over blocked threads:
+ * `UnUse` hands the released slot directly to the oldest one and resumes it.
+ *
+ * ### Example
+ * ```cpp
+ * CBlockingObjectPool<CConnection> connections(8);
+ *
+ * size_t id;
+ * auto result = connections.UseNextFor(id, std::chrono::milliseconds(50));
+ * if (!result.has_value())
+ *     return; // all 8 connections stayed busy for 50 ms
+ * (*result)->Query("...");
+ * (void)connections.UnUse(id);
+ * ```
+ *
+ * The returned pointer stays valid until the slot is released with `UnUse`. The pool
+ * only synchronizes the occupancy, access to the object is up to its current owner.
+ *
+ * @tparam T Object type, must be default-constructible.
+ * @tparam TStats Statistics policy, see `CObjectPool`.
+ * @tparam TObserver Observer policy, see `CObjectPool`. Its hooks are called with the mutex held.
+ */
+template <pool_object T, pool_stats TStats = CNoPoolStats, pool_observer TObserver = CNoPoolObserver>
+class CBlockingObjectPool
+{
+public:
+	using TPool = CObjectPool<T, TStats, TObserver>;
+	using TResult = typename TPool::TResult;
+	using TResultVoid = typename TPool::TResultVoid;
+
+	/**
+	 * @brief Intrusive node of the FIFO list of suspended `AcquireAsync` callers.
+	 *
+	 * Lives inside the awaiter, i.e. in the frame of the suspended coroutine,
+	 * so queueing a waiter never allocates.
+	 */
+	struct CWaiter
+	{
+		CWaiter* pNext = nullptr;
+		size_t* pFoundPos = nullptr;
+		TResult result = std::unexpected(EPoolError::FULL);
+		std::coroutine_handle<> handle;
+		/** Hands `handle` to the executor of the concrete awaiter. */
+		void (*pResume)(CWaiter& waiter) noexcept = nullptr;
+	};
+
+	/**
+	 * @class CBlockingObjectPool::CAcquireAwaiter
+	 * @brief Awaitable returned by `AcquireAsync`, resolves to the acquired object.
+	 *
+	 * @tparam TExecutor Resumes the coroutine once a slot was handed over.
+	 */
+	template <coroutine_executor TExecutor>
+	class CAcquireAwaiter : CWaiter
+	{
+	public:
+		CAcquireAwaiter(CBlockingObjectPool& pool, size_t& found_pos, TExecutor executor)
+			: pPool(&pool),
+			  executor(std::move(executor))
+		{
+			this->pFoundPos = &found_pos;
+			this->pResume = &Resume;
+		}
+
+		/** @brief Acquires right away if a slot is free. */
+		bool await_ready() noexcept
+		{
+			return pPool->TryAcquireAsync(*this);
+		}
+
+		/** @brief Queues the coroutine, unless a slot was freed meanwhile. */
+		bool await_suspend(const std::coroutine_handle<> handle) noexcept
+		{
+			this->handle = handle;
+			return pPool->EnqueueWaiter(*this);
+		}
+
+		TResult await_resume() noexcept
+		{
+			return this->result;
+		}
+
+	private:
+		static void Resume(CWaiter& waiter) noexcept
+		{
+			auto& self = static_cast<CAcquireAwaiter&>(waiter);
+			// the awaiter dies with the coroutine frame, which might happen on another thread
+			// as soon as the executor scheduled it, so nothing may be touched afterward
+			TExecutor resumeOn = std::move(self.executor);
+			resumeOn(self.handle);
+		}
+
+		CBlockingObjectPool* pPool;
+		TExecutor executor;
+	};
+
+	/**
+	 * @brief Constructs the underlying pool with given size and constructor arguments.
+	 * @param size Number of elements to preallocate.
+	 * @param args Optional arguments forwarded to the `CObjectPool` constructor.
+	 */
+	template <typename... Args>
+	explicit CBlockingObjectPool(size_t size, Args&&... args);
+
+	// The mutex and waiting threads refer to the pool, so it can't be copied or moved
+	CBlockingObjectPool(const CBlockingObjectPool&) = delete;
+	CBlockingObjectPool(CBlockingObjectPool&&) = delete;
+	CBlockingObjectPool& operator=(const CBlockingObjectPool&) = delete;
+	CBlockingObjectPool& operator=(CBlockingObjectPool&&) = delete;
+
+	/** @brief Thread-safe `CObjectPool::UseNext`, returns `FULL` immediately if no slot is free. */
+	[[nodiscard]]
+	TResult UseNext(size_t& found_pos) noexcept;
+	/**
+	 * @brief Acquires the next free slot, waiting as long as the pool is full.
+	 *
+	 * @param found_pos Receives the index of the acquired slot.
+	 * @return Pointer to the acquired object.
+	 */
+	[[nodiscard]]
+	TResult UseNextWait(size_t& found_pos);
+	/**
+	 * @brief Acquires the next free slot, waiting at most `timeout` for one to become free.
+	 *
+	 * @param found_pos Receives the index of the acquired slot.
+	 * @param timeout Maximum time to wait.
+	 * @return Pointer to the acquired object, or `FULL` if the pool stayed full.
+	 */
+	template <typename Rep, typename Period>
+	[[nodiscard]]
+	TResult UseNextFor(size_t& found_pos, const std::chrono::duration<Rep, Period>& timeout);
+	/**
+	 * @brief Acquires the next free slot, waiting until `deadline` at the latest.
+	 *
+	 * @param found_pos Receives the index of the acquired slot.
+	 * @param deadline Point in time after which the call gives up.
+	 * @return Pointer to the acquired object, or `FULL` if the pool stayed full.
+	 */
+	template <typename Clock, typename Duration>
+	[[nodiscard]]
+	TResult UseNextUntil(size_t& found_pos, const std::chrono::time_point<Clock, Duration>& deadline);
+	/**
+	 * @brief Returns an awaitable acquiring the next free slot without blocking a thread.
+	 *
+	 * Completes immediately if a slot is free, otherwise the coroutine is suspended and
+	 * queued. The `UnUse` freeing the slot for it resumes it via `executor`, which runs
+	 * it inline on the releasing thread by default, see `CInlineExecutor`. The executor
+	 * must not throw, see `coroutine_executor`. A suspended coroutine must not be
+	 * destroyed before it was resumed.
+	 *
+	 * ```cpp
+	 * size_t id;
+	 * auto result = co_await buffers.AcquireAsync(id);
+	 * ```
+	 *
+	 * @param found_pos Receives the index of the acquired slot, must outlive the suspension.
+	 * @param executor Callable `executor(std::coroutine_handle<>)` resuming the coroutine.
+	 * @return Awaitable resolving to the pointer of the acquired object.
+	 */
+	template <coroutine_executor TExecutor = CInlineExecutor>
+	[[nodiscard]]
+	CAcquireAwaiter<TExecutor> AcquireAsync(size_t& found_pos, TExecutor executor = {});
+	/**
+	 * @brief Thread-safe `CObjectPool::UnUse`, hands the slot to one waiting acquirer on success.
+	 *
+	 * @param pos Index to deactivate.
+	 * @param args Optional arguments for reinitializing the element.
+	 * @return Empty `expected` on success, or error (`OUT_OF_RANGE`, `ALREADY_UNUSED`) otherwise.
+	 */
+	template <typename... Args>
+	TResultVoid UnUse(size_t pos, Args&&... args) noexcept;
+
+	/** @brief Thread-safe `CObjectPool::Get`. */
+	[[nodiscard]]
+	TResult Get(size_t pos) noexcept;
+	/** @brief Thread-safe `CObjectPool::IsInUse`. */
+	[[nodiscard]]
+	bool IsInUse(size_t pos) const noexcept;
+	/** @brief Returns the total number of slots in the pool. */
+	[[nodiscard]]
+	size_t Size() const noexcept;
+	/** @brief Returns the number of currently active (used) objects. */
+	[[nodiscard]]
+	size_t ObjectsInUse() const noexcept;
+	/**
+	 * @brief Calls `func(TPool&)` with the mutex held, e.g. to iterate or read the statistics.
+	 *
+	 * Releasing slots inside `func` doesn't wake waiters, use `UnUse` for that.
+	 */
+	template <typename TFunc>
+	decltype(auto) WithLock(TFunc&& func);
+
+protected:
+	/** @brief Returns whether a waiting acquirer can proceed, requires `mutex` to be held. */
+	[[nodiscard]]
+	bool HasFreeSlot() const noexcept;
+	/** @brief Acquires a slot for `waiter` if one is free and nobody is queued before it. */
+	[[nodiscard]]
+	bool TryAcquireAsync(CWaiter& waiter) noexcept;
+	/**
+	 * @brief Appends `waiter` to the queue.
+	 * @return `false` if a slot became free meanwhile and was acquired instead.
+	 */
+	[[nodiscard]]
+	bool EnqueueWaiter(CWaiter& waiter) noexcept;
+
+	TPool pool;
+	mutable std::mutex mutex;
+	std::condition_variable slotFreed;
+	CWaiter* pWaitersHead = nullptr;
+	CWaiter* pWaitersTail = nullptr;
+};
+
+// implementation
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver>
+template <typename... Args>
+CBlockingObjectPool<T, TStats, TObserver>::CBlockingObjectPool(const size_t size, Args&&... args)
+	: pool(size, std::forward<Args>(args)...)
+{}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver>
+CBlockingObjectPool<T, TStats, TObserver>::TResult CBlockingObjectPool<T, TStats, TObserver>::UseNext(size_t& found_pos) noexcept
+{
+	std::scoped_lock lock(mutex);
+	return pool.UseNext(found_pos);
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver>
+CBlockingObjectPool<T, TStats, TObserver>::TResult CBlockingObjectPool<T, TStats, TObserver>::UseNextWait(size_t& found_pos)
+{
+	std::unique_lock lock(mutex);
+	slotFreed.wait(lock, [this] { return HasFreeSlot(); });
+	return pool.UseNext(found_pos);
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver>
+template <typename Rep, typename Period>
+CBlockingObjectPool<T, TStats, TObserver>::TResult CBlockingObjectPool<T, TStats, TObserver>::UseNextFor(size_t& found_pos, const std::chrono::duration<Rep, Period>& timeout)
+{
+	return UseNextUntil(found_pos, std::chrono::steady_clock::now() + timeout);
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver>
+template <typename Clock, typename Duration>
+CBlockingObjectPool<T, TStats, TObserver>::TResult CBlockingObjectPool<T, TStats, TObserver>::UseNextUntil(size_t& found_pos, const std::chrono::time_point<Clock, Duration>& deadline)
+{
+	std::unique_lock lock(mutex);
+	// on timeout the pool is still full and UseNext reports FULL (and records it in the policies)
+	(void)slotFreed.wait_until(lock, deadline, [this] { return HasFreeSlot(); });
+	return pool.UseNext(found_pos);
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver>
+template <coroutine_executor TExecutor>
+CBlockingObjectPool<T, TStats, TObserver>::CAcquireAwaiter<TExecutor> CBlockingObjectPool<T, TStats, TObserver>::AcquireAsync(size_t& found_pos, TExecutor executor)
+{
+	return CAcquireAwaiter<TExecutor>(*this, found_pos, std::move(executor));
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver>
+template <typename... Args>
+CBlockingObjectPool<T, TStats, TObserver>::TResultVoid CBlockingObjectPool<T, TStats, TObserver>::UnUse(const size_t pos, Args&&... args) noexcept
+{
+	TResultVoid result;
+	CWaiter* pWaiter = nullptr;
+	{
+		std::scoped_lock lock(mutex);
+		result = pool.UnUse(pos, std::forward<Args>(args)...);
+		if (result.has_value() && pWaitersHead != nullptr)
+		{
+			// hand the slot over while locked, so no other acquirer can take it first
+			pWaiter = pWaitersHead;
+			pWaitersHead = pWaiter->pNext;
+			if (pWaitersHead == nullptr)
+				pWaitersTail = nullptr;
+			pWaiter->result = pool.UseNext(*pWaiter->pFoundPos);
+		}
+	}
+	// resume or notify without the lock held, so the woken side doesn't block on it right away
+	if (pWaiter != nullptr)
+		pWaiter->pResume(*pWaiter);
+	else if (result.has_value())
+		slotFreed.notify_one();
+	return result;
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver>
+CBlockingObjectPool<T, TStats, TObserver>::TResult CBlockingObjectPool<T, TStats, TObserver>::Get(const size_t pos) noexcept
+{
+	std::scoped_lock lock(mutex);
+	return pool.Get(pos);
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver>
+bool CBlockingObjectPool<T, TStats, TObserver>::IsInUse(const size_t pos) const noexcept
+{
+	std::scoped_lock lock(mutex);
+	return pool.IsInUse(pos);
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver>
+size_t CBlockingObjectPool<T, TStats, TObserver>::Size() const noexcept
+{
+	return pool.Size();
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver>
+size_t CBlockingObjectPool<T, TStats, TObserver>::ObjectsInUse() const noexcept
+{
+	std::scoped_lock lock(mutex);
+	return pool.ObjectsInUse();
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver>
+template <typename TFunc>
+decltype(auto) CBlockingObjectPool<T, TStats, TObserver>::WithLock(TFunc&& func)
+{
+	std::scoped_lock lock(mutex);
+	return std::forward<TFunc>(func)(pool);
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver>
+bool CBlockingObjectPool<T, TStats, TObserver>::HasFreeSlot() const noexcept
+{
+	return pool.ObjectsInUse() < pool.Size();
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver>
+bool CBlockingObjectPool<T, TStats, TObserver>::TryAcquireAsync(CWaiter& waiter) noexcept
+{
+	std::scoped_lock lock(mutex);
+	if (pWaitersHead != nullptr || !HasFreeSlot())
+		return false;
+	waiter.result = pool.UseNext(*waiter.pFoundPos);
+	return true;
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver>
+bool CBlockingObjectPool<T, TStats, TObserver>::EnqueueWaiter(CWaiter& waiter) noexcept
+{
+	std::scoped_lock lock(mutex);
+	if (pWaitersHead == nullptr && HasFreeSlot())
+	{
+		waiter.result = pool.UseNext(*waiter.pFoundPos);
+		return false;
+	}
+	waiter.pNext = nullptr;
+	if (pWaitersTail != nullptr)
+		pWaitersTail->pNext = &waiter;
+	else
+		pWaitersHead = &waiter;
+	pWaitersTail = &waiter;
+	return true;
+}
+}
@@ -0,0 +1,561 @@
+// -----------------------------------------------------------------------------
+// CConcurrentObjectPool.hpp
+// Object pool whose active objects can be iterated while other threads acquire
+// and release slots, using epoch-based deferred reclamation.
+// Author: Daniel Contu (Migos) — https://github.com/AbsintheScripting
+// -----------------------------------------------------------------------------
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "CObjectPool.hpp"
+
+namespace ObjectPool
+{
+/**
+ * @class CConcurrentObjectPool
+ * @brief Fixed-size object pool where readers iterate without a lock while writers acquire and release.
+ *
+ * Writers (`Use`, `UseNext`, `Publish`, `UnUse`, `Reclaim`) are serialized by an internal
+ * mutex. Readers enter an epoch with `Read()`, which captures a consistent snapshot of the
+ * *published* objects, and walk it through the returned `CReadGuard`. Readers only take the
+ * writer mutex when writers keep them from taking the snapshot, see `CReadGuard`.
+ *
+ * A slot goes through the states
+ * `free -> claimed (UseNext) -> published (Publish) -> retired (UnUse) -> free (Reclaim)`.
+ * A claimed slot is invisible to readers until it is published, so the writer can
+ * initialize the object first. `UnUse` only hides the object from new readers and
+ * retires the slot; the object is reset and the slot reused once every reader that
+ * could still see it has left its epoch. Retired slots are reclaimed lazily by
+ * `UnUse`/`UseNext`, or explicitly by `Reclaim()`.
+ *
+ * ### Example
+ * ```cpp
+ * CConcurrentObjectPool<CParticle> particles(1024);
+ *
+ * // gameplay thread
+ * size_t id;
+ * if (auto result = particles.UseNext(id))
+ * {
+ *     (*result)->Spawn(position);
+ *     (void)particles.Publish(id);
+ * }
+ *
+ * // render thread
+ * std::vector<uint64_t> snapshot; // reused every frame
+ * {
+ *     auto guard = particles.Read(snapshot);
+ *     guard.ForEachActive([&](const CParticle& particle) { Draw(particle); });
+ * } // retired particles can be reset now
+ * ```
+ *
+ * Readers get `const T&` only. Modifying a published object while readers are
+ * active must be synchronized by `T` itself.
+ *
+ * @tparam T Object type, must be default-constructible.
+ */
+template <pool_object T>
+class CConcurrentObjectPool
+{
+public:
+	using TResult = std::expected<T*, EPoolError>;
+	using TResultConst = std::expected<const T*, EPoolError>;
+	using TResultVoid = std::expected<void, EPoolError>;
+
+	/**
+	 * @class CConcurrentObjectPool::CReadGuard
+	 * @brief Snapshot of the published slots, keeping the reader in its epoch while the guard lives.
+	 *
+	 * The occupancy is copied once when the guard is created, as a seqlock read: the copy
+	 * is retried if a writer published or retired a slot meanwhile, so it always equals the
+	 * published set at one point in time between the start and the end of `Read()`. After
+	 * `MAX_READ_RETRIES` failed attempts the reader copies under the writer mutex instead,
+	 * so writers which acquire and release continuously can't starve it.
+	 * `ForEachActive`, `Get` and `IsInUse` all answer from that snapshot, so iteration is
+	 * linearizable with respect to the writers and repeated reads through the same guard agree.
+	 * Slots published later are not visible, slots retired later stay visible and their
+	 * objects are not reset until the guard is destroyed.
+	 *
+	 * Taking the snapshot copies one bit per slot (`Size() / 8` bytes). The guard either owns
+	 * the copy, which allocates, or writes it into a buffer the reader passes in and reuses,
+	 * which only allocates the first time.
+	 */
+	class CReadGuard
+	{
+	public:
+		/** @brief Enters the current epoch and snapshots the published slots, may throw `std::bad_alloc`. */
+		explicit CReadGuard(const CConcurrentObjectPool& pool);
+		/**
+		 * @brief Like the constructor above, but keeps the snapshot in `buffer`.
+		 *
+		 * `buffer` must outlive the guard and can't be shared by two guards alive at the same time.
+		 * It is only resized (and may throw `std::bad_alloc`) if it doesn't fit the pool yet.
+		 */
+		CReadGuard(const CConcurrentObjectPool& pool, std::vector<uint64_t>& buffer);
+		~CReadGuard();
+
+		CReadGuard(const CReadGuard&) = delete;
+		CReadGuard& operator=(const CReadGuard&) = delete;
+
+		/** @brief Calls `func(const T&)` for every published object. */
+		template <typename TFunc>
+		void ForEachActive(TFunc&& func) const;
+		/**
+		 * @brief Gets read-only access to the published object at `pos`.
+		 * @return Pointer valid for the lifetime of the guard, or `OUT_OF_RANGE`/`NOT_IN_USE`.
+		 */
+		[[nodiscard]]
+		TResultConst Get(size_t pos) const noexcept;
+		/** @brief Checks whether the object at `pos` is published. */
+		[[nodiscard]]
+		bool IsInUse(size_t pos) const noexcept;
+
+	private:
+		const CConcurrentObjectPool& pool;
+		size_t readerSlot;
+		/** Snapshot storage if the reader didn't pass a buffer. */
+		std::vector<uint64_t> ownWords;
+		/** Published slots when the guard was created, one bit per slot. */
+		const std::vector<uint64_t>& occupancy;
+	};
+
+	/**
+	 * @brief Constructs a pool with given size and default-constructs every slot.
+	 * @param size Number of elements to preallocate.
+	 */
+	explicit CConcurrentObjectPool(size_t size);
+	/**
+	 * @brief Constructs a pool with given size and constructs every slot with `args`.
+	 *
+	 * Reclaimed slots are reset with the default constructor.
+	 */
+	template <typename... Args>
+	explicit CConcurrentObjectPool(size_t size, Args&&... args);
+	~CConcurrentObjectPool();
+
+	// Readers hold references into the pool, so it can't be copied or moved
+	CConcurrentObjectPool(const CConcurrentObjectPool&) = delete;
+	CConcurrentObjectPool(CConcurrentObjectPool&&) = delete;
+	CConcurrentObjectPool& operator=(const CConcurrentObjectPool&) = delete;
+	CConcurrentObjectPool& operator=(CConcurrentObjectPool&&) = delete;
+
+	/**
+	 * @brief Claims the slot at `pos` for the calling writer, without publishing it.
+	 * @return Pointer to the object, or `OUT_OF_RANGE`/`ALREADY_IN_USE`.
+	 */
+	[[nodiscard]]
+	TResult Use(size_t pos) noexcept;
+	/**
+	 * @brief Claims the next free slot, reclaiming retired slots if the pool is full.
+	 *
+	 * @param found_pos Receives the index of the claimed slot.
+	 * @return Pointer to the object, or `FULL` if no slot is free or reclaimable.
+	 */
+	[[nodiscard]]
+	TResult UseNext(size_t& found_pos) noexcept;
+	/**
+	 * @brief Makes a claimed slot visible to readers.
+	 * @return Empty `expected` on success, or `OUT_OF_RANGE`/`NOT_IN_USE`/`ALREADY_IN_USE`.
+	 */
+	TResultVoid Publish(size_t pos) noexcept;
+	/**
+	 * @brief Hides the object from new readers and retires its slot.
+	 *
+	 * The object is reset with its default constructor once all readers which might
+	 * still see it have finished. Claimed but unpublished slots are retired as well.
+	 *
+	 * @return Empty `expected` on success, or `OUT_OF_RANGE`/`ALREADY_UNUSED`.
+	 */
+	TResultVoid UnUse(size_t pos) noexcept;
+	/**
+	 * @brief Advances the epoch if possible and resets every retired slot no reader can see anymore.
+	 * @return Number of slots that became free.
+	 */
+	size_t Reclaim() noexcept;
+
+	/** @brief Enters a read epoch and snapshots the published slots, see `CReadGuard`. */
+	[[nodiscard]]
+	CReadGuard Read() const;
+	/** @brief Like `Read()`, but snapshots into `buffer`, which the reader reuses across guards. */
+	[[nodiscard]]
+	CReadGuard Read(std::vector<uint64_t>& buffer) const;
+
+	/** @brief Returns the total number of slots in the pool. */
+	[[nodiscard]]
+	size_t Size() const noexcept;
+	/** @brief Returns the number of claimed or published objects (retired slots excluded). */
+	[[nodiscard]]
+	size_t ObjectsInUse() const noexcept;
+	/** @brief Returns the number of retired slots waiting for reclamation. */
+	[[nodiscard]]
+	size_t RetiredCount() const noexcept;
+
+protected:
+	struct CObject
+	{
+		alignas(T) std::byte object[sizeof(T)];
+	};
+
+	/** @brief A retired slot together with the epoch it was retired in. */
+	struct CRetired
+	{
+		size_t pos;
+		uint64_t epoch;
+	};
+
+	/** @brief Writer-side state of a slot besides `Detail::FLAG_FREE` and `Detail::FLAG_USED` (claimed). */
+	static constexpr uint8_t FLAG_RETIRED = 2;
+	/** @brief Lock-free snapshot attempts before a reader falls back to the writer mutex. */
+	static constexpr int32_t MAX_READ_RETRIES = 8;
+
+	[[nodiscard]]
+	T* Object(size_t pos) noexcept;
+	[[nodiscard]]
+	const T* Object(size_t pos) const noexcept;
+	/** @brief Registers a reader in the current epoch and returns its counter index. */
+	size_t EnterEpoch() const noexcept;
+	/** @brief Copies the published bitmap into `words`, locking out the writers if they keep interfering. */
+	void CopyPublished(std::vector<uint64_t>& words) const;
+	/** @brief Sets or clears the published bit of `pos` inside a write section of `version`. */
+	void SetPublished(size_t pos, bool b_published) noexcept;
+	/** @brief Starts a new epoch if no reader of the epoch before the current one is left. */
+	void TryAdvanceEpoch() noexcept;
+	/** @brief `Reclaim` for callers already holding `writerMutex`. */
+	size_t ReclaimLocked() noexcept;
+
+	const size_t poolSize;
+	size_t nextIdx;
+	std::atomic<size_t> objectsInUse;
+	std::vector<CObject> pool;
+	/** Writer-side slot states, only accessed with `writerMutex` held, so the SIMD scan can be used. */
+	std::vector<uint8_t> claimed;
+	/** Reader-side bitmap of the published objects, one bit per slot. */
+	std::vector<std::atomic<uint64_t>> live;
+	/** Seqlock counter guarding `live`, odd while a writer changes it. */
+	std::atomic<uint64_t> version;
+	std::vector<CRetired> retired;
+	mutable std::mutex writerMutex;
+	std::atomic<uint64_t> epoch;
+	/** Active readers per epoch parity. */
+	mutable std::array<std::atomic<size_t>, 2> readers;
+};
+
+// implementation
+
+template <pool_object T>
+CConcurrentObjectPool<T>::CConcurrentObjectPool(const size_t size)
+	: poolSize(size),
+	  nextIdx(0),
+	  objectsInUse(0),
+	  pool(size),
+	  claimed(size),
+	  live((size + 63) / 64),
+	  version(0),
+	  epoch(0),
+	  readers{}
+{
+	retired.reserve(size); // every slot is retired at most once, so UnUse never allocates
+	for (size_t pos = 0; pos < poolSize; ++pos)
+		::new(&pool[pos].object) T();
+}
+
+template <pool_object T>
+template <typename... Args>
+CConcurrentObjectPool<T>::CConcurrentObjectPool(const size_t size, Args&&... args)
+	: poolSize(size),
+	  nextIdx(0),
+	  objectsInUse(0),
+	  pool(size),
+	  claimed(size),
+	  live((size + 63) / 64),
+	  version(0),
+	  epoch(0),
+	  readers{}
+{
+	retired.reserve(size); // every slot is retired at most once, so UnUse never allocates
+	for (size_t pos = 0; pos < poolSize; ++pos)
+		::new(&pool[pos].object) T(std::forward<Args>(args)...);
+}
+
+template <pool_object T>
+CConcurrentObjectPool<T>::~CConcurrentObjectPool()
+{
+	for (size_t pos = 0; pos < poolSize; ++pos)
+		std::destroy_at(Object(pos));
+}
+
+template <pool_object T>
+CConcurrentObjectPool<T>::TResult CConcurrentObjectPool<T>::Use(const size_t pos) noexcept
+{
+	if (pos >= poolSize)
+		return std::unexpected(EPoolError::OUT_OF_RANGE);
+
+	std::scoped_lock lock(writerMutex);
+	if (claimed[pos] != Detail::FLAG_FREE)
+		return std::unexpected(EPoolError::ALREADY_IN_USE);
+
+	claimed[pos] = Detail::FLAG_USED;
+	objectsInUse.fetch_add(1, std::memory_order_relaxed);
+	return Object(pos);
+}
+
+template <pool_object T>
+CConcurrentObjectPool<T>::TResult CConcurrentObjectPool<T>::UseNext(size_t& found_pos) noexcept
+{
+	std::scoped_lock lock(writerMutex);
+	size_t pos = Detail::FindFlagWrapped(claimed.data(), poolSize, nextIdx, Detail::FLAG_FREE);
+	if (pos == poolSize && ReclaimLocked() != 0)
+		pos = Detail::FindFlagWrapped(claimed.data(), poolSize, nextIdx, Detail::FLAG_FREE);
+	if (pos == poolSize)
+		return std::unexpected(EPoolError::FULL);
+
+	claimed[pos] = Detail::FLAG_USED;
+	found_pos = pos;
+	nextIdx = pos + 1 < poolSize ? pos + 1 : 0;
+	objectsInUse.fetch_add(1, std::memory_order_relaxed);
+	return Object(pos);
+}
+
+template <pool_object T>
+CConcurrentObjectPool<T>::TResultVoid CConcurrentObjectPool<T>::Publish(const size_t pos) noexcept
+{
+	if (pos >= poolSize)
+		return std::unexpected(EPoolError::OUT_OF_RANGE);
+
+	std::scoped_lock lock(writerMutex);
+	if (claimed[pos] != Detail::FLAG_USED)
+		return std::unexpected(EPoolError::NOT_IN_USE);
+	if ((live[pos / 64].load(std::memory_order_relaxed) >> (pos % 64) & 1) != 0)
+		return std::unexpected(EPoolError::ALREADY_IN_USE);
+
+	SetPublished(pos, true);
+	return {};
+}
+
+template <pool_object T>
+CConcurrentObjectPool<T>::TResultVoid CConcurrentObjectPool<T>::UnUse(const size_t pos) noexcept
+{
+	if (pos >= poolSize)
+		return std::unexpected(EPoolError::OUT_OF_RANGE);
+
+	std::scoped_lock lock(writerMutex);
+	if (claimed[pos] != Detail::FLAG_USED)
+		return std::unexpected(EPoolError::ALREADY_UNUSED);
+
+	// hide the object first, then read the epoch: a reader which could still see
+	// the object has entered this epoch or an earlier one
+	SetPublished(pos, false);
+	claimed[pos] = FLAG_RETIRED;
+	retired.push_back({pos, epoch.load(std::memory_order_seq_cst)});
+	objectsInUse.fetch_sub(1, std::memory_order_relaxed);
+	(void)ReclaimLocked();
+	return {};
+}
+
+template <pool_object T>
+size_t CConcurrentObjectPool<T>::Reclaim() noexcept
+{
+	std::scoped_lock lock(writerMutex);
+	return ReclaimLocked();
+}
+
+template <pool_object T>
+CConcurrentObjectPool<T>::CReadGuard CConcurrentObjectPool<T>::Read() const
+{
+	return CReadGuard(*this);
+}
+
+template <pool_object T>
+CConcurrentObjectPool<T>::CReadGuard CConcurrentObjectPool<T>::Read(std::vector<uint64_t>& buffer) const
+{
+	return CReadGuard(*this, buffer);
+}
+
+template <pool_object T>
+size_t CConcurrentObjectPool<T>::Size() const noexcept
+{
+	return poolSize;
+}
+
+template <pool_object T>
+size_t CConcurrentObjectPool<T>::ObjectsInUse() const noexcept
+{
+	return objectsInUse.load(std::memory_order_relaxed);
+}
+
+template <pool_object T>
+size_t CConcurrentObjectPool<T>::RetiredCount() const noexcept
+{
+	std::scoped_lock lock(writerMutex);
+	return retired.size();
+}
+
+template <pool_object T>
+T* CConcurrentObjectPool<T>::Object(const size_t pos) noexcept
+{
+	return std::launder(reinterpret_cast<T*>(&pool[pos].object));
+}
+
+template <pool_object T>
+const T* CConcurrentObjectPool<T>::Object(const size_t pos) const noexcept
+{
+	return std::launder(reinterpret_cast<const T*>(&pool[pos].object));
+}
+
+template <pool_object T>
+size_t CConcurrentObjectPool<T>::EnterEpoch() const noexcept
+{
+	while (true)
+	{
+		const uint64_t current = epoch.load(std::memory_order_seq_cst);
+		const size_t slot = current & 1;
+		readers[slot].fetch_add(1, std::memory_order_seq_cst);
+		// the epoch might have advanced between the load and the registration
+		if (epoch.load(std::memory_order_seq_cst) == current)
+			return slot;
+		readers[slot].fetch_sub(1, std::memory_order_seq_cst);
+	}
+}
+
+template <pool_object T>
+void CConcurrentObjectPool<T>::CopyPublished(std::vector<uint64_t>& words) const
+{
+	words.resize(live.size());
+	for (int32_t attempt = 0; attempt < MAX_READ_RETRIES; ++attempt)
+	{
+		const uint64_t before = version.load(std::memory_order_acquire);
+		if ((before & 1) == 0)
+		{
+			// seq_cst like the epoch registration before, see `ReclaimLocked`
+			for (size_t word = 0; word < live.size(); ++word)
+				words[word] = live[word].load(std::memory_order_seq_cst);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (version.load(std::memory_order_relaxed) == before)
+				return;
+		}
+	}
+
+	// writers only change `live` with the mutex held, so no write section can be open
+	std::scoped_lock lock(writerMutex);
+	for (size_t word = 0; word < live.size(); ++word)
+		words[word] = live[word].load(std::memory_order_seq_cst);
+}
+
+template <pool_object T>
+void CConcurrentObjectPool<T>::SetPublished(const size_t pos, const bool b_published) noexcept
+{
+	// writers are serialized by `writerMutex`, so the counter has a single writer
+	const uint64_t current = version.load(std::memory_order_relaxed);
+	version.store(current + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	const uint64_t bit = uint64_t{1} << (pos % 64);
+	if (b_published)
+		live[pos / 64].fetch_or(bit, std::memory_order_seq_cst);
+	else
+		live[pos / 64].fetch_and(~bit, std::memory_order_seq_cst);
+	// release: readers of the new version also see the initialized object
+	version.store(current + 2, std::memory_order_release);
+}
+
+template <pool_object T>
+void CConcurrentObjectPool<T>::TryAdvanceEpoch() noexcept
+{
+	// readers of `current - 1` share the counter with `current + 1`,
+	// which can't have readers yet
+	const uint64_t current = epoch.load(std::memory_order_seq_cst);
+	if (readers[(current + 1) & 1].load(std::memory_order_seq_cst) == 0)
+		epoch.store(current + 1, std::memory_order_seq_cst);
+}
+
+template <pool_object T>
+size_t CConcurrentObjectPool<T>::ReclaimLocked() noexcept
+{
+	if (retired.empty())
+		return 0;
+
+	// two advances free everything retired before this call if no reader blocks them
+	TryAdvanceEpoch();
+	TryAdvanceEpoch();
+	const uint64_t current = epoch.load(std::memory_order_seq_cst);
+
+	// slots retired in epoch `e` are invisible to every reader once the epoch reached `e + 2`
+	size_t freed = 0;
+	while (freed < retired.size() && retired[freed].epoch + 2 <= current)
+	{
+		const size_t pos = retired[freed].pos;
+		std::destroy_at(Object(pos));
+		::new(&pool[pos].object) T();
+		claimed[pos] = Detail::FLAG_FREE;
+		++freed;
+	}
+	retired.erase(retired.begin(), retired.begin() + static_cast<std::ptrdiff_t>(freed));
+	return freed;
+}
+
+template <pool_object T>
+CConcurrentObjectPool<T>::CReadGuard::CReadGuard(const CConcurrentObjectPool& pool)
+	// `ownWords` is constructed by the target constructor before it copies into it
+	: CReadGuard(pool, ownWords)
+{
+}
+
+template <pool_object T>
+CConcurrentObjectPool<T>::CReadGuard::CReadGuard(const CConcurrentObjectPool& pool, std::vector<uint64_t>& buffer)
+	: pool(pool),
+	  readerSlot(pool.EnterEpoch()),
+	  occupancy(buffer)
+{
+	// snapshot after entering the epoch, so every object in it stays valid
+	try
+	{
+		pool.CopyPublished(buffer);
+	}
+	catch (...)
+	{
+		pool.readers[readerSlot].fetch_sub(1, std::memory_order_seq_cst);
+		throw;
+	}
+}
+
+template <pool_object T>
+CConcurrentObjectPool<T>::CReadGuard::~CReadGuard()
+{
+	pool.readers[readerSlot].fetch_sub(1, std::memory_order_seq_cst);
+}
+
+template <pool_object T>
+template <typename TFunc>
+void CConcurrentObjectPool<T>::CReadGuard::ForEachActive(TFunc&& func) const
+{
+	for (size_t word = 0; word < occupancy.size(); ++word)
+	{
+		for (uint64_t bits = occupancy[word]; bits != 0; bits &= bits - 1)
+			func(*pool.Object(word * 64 + static_cast<size_t>(std::countr_zero(bits))));
+	}
+}
+
+template <pool_object T>
+CConcurrentObjectPool<T>::TResultConst CConcurrentObjectPool<T>::CReadGuard::Get(const size_t pos) const noexcept
+{
+	if (pos >= pool.poolSize)
+		return std::unexpected(EPoolError::OUT_OF_RANGE);
+	if (!IsInUse(pos))
+		return std::unexpected(EPoolError::NOT_IN_USE);
+	return pool.Object(pos);
+}
+
+template <pool_object T>
+bool CConcurrentObjectPool<T>::CReadGuard::IsInUse(const size_t pos) const noexcept
+{
+	return pos < pool.poolSize && (occupancy[pos / 64] >> (pos % 64) & 1) != 0;
+}
+}
@@ -0,0 +1,610 @@
+// -----------------------------------------------------------------------------
+// CMappedObjectPool.hpp
+// Object pool whose objects and occupancy live in a memory-mapped file,
+// so a pool survives process restarts and re-opens without rebuilding.
+// Author: Daniel Contu (Migos) — https://github.com/AbsintheScripting
+// -----------------------------------------------------------------------------
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "CObjectPool.hpp"
+
+namespace ObjectPool
+{
+/**
+ * @brief Error codes for creating or opening a memory-mapped pool.
+ */
+enum class EMappedPoolError : uint8_t
+{
+	OPEN_FAILED,
+	MAPPING_FAILED,
+	SYNC_FAILED,
+	INVALID_HEADER,
+	VERSION_MISMATCH,
+	TYPE_MISMATCH,
+	LOCKED
+};
+
+/** Utility function to convert the error into text, e.g., for logging */
+[[nodiscard]]
+constexpr const char* ToString(const EMappedPoolError& error) noexcept
+{
+	switch (error)
+	{
+	case EMappedPoolError::OPEN_FAILED: return "Failed to open or resize the file";
+	case EMappedPoolError::MAPPING_FAILED: return "Failed to map the file";
+	case EMappedPoolError::SYNC_FAILED: return "Failed to write the mapping back to the file";
+	case EMappedPoolError::INVALID_HEADER: return "File is not a pool or is truncated";
+	case EMappedPoolError::VERSION_MISMATCH: return "Pool file has an unsupported version";
+	case EMappedPoolError::TYPE_MISMATCH: return "Pool file stores objects of a different size or alignment";
+	case EMappedPoolError::LOCKED: return "Pool file is already opened by another pool";
+	default: return "Unknown mapped pool error";
+	}
+}
+
+/**
+ * @brief Header at the start of every pool file.
+ *
+ * Describes the layout, so a file written for another `T` or by an incompatible
+ * version is rejected by `CMappedObjectPool::Open` instead of being misread.
+ */
+struct CMappedPoolHeader
+{
+	/** @brief `"OBJPOOL"` followed by a zero byte, read as little-endian integer. */
+	static constexpr uint64_t MAGIC = 0x004C4F4F504A424FULL;
+	/** @brief Bumped whenever the file layout changes. */
+	static constexpr uint32_t VERSION = 1;
+
+	uint64_t magic;
+	uint32_t version;
+	uint32_t typeSize;
+	uint32_t typeAlign;
+	uint32_t reserved;
+	uint64_t capacity;
+	uint64_t objectsInUse;
+	uint64_t nextIdx;
+};
+
+namespace Detail
+{
+/**
+ * @class CMemoryMapping
+ * @brief Owns a shared, writable mapping of a file descriptor and unmaps it on destruction.
+ *
+ * A mapping made by `Map` doesn't need the descriptor, the mapping keeps the file alive.
+ * `MapFile` keeps its descriptor open to hold an exclusive advisory lock on the file for
+ * the lifetime of the mapping.
+ */
+class CMemoryMapping
+{
+public:
+	using TResult = std::expected<CMemoryMapping, EMappedPoolError>;
+
+	CMemoryMapping() = default;
+
+	~CMemoryMapping()
+	{
+		if (pData != nullptr)
+			::munmap(pData, size);
+		// closing the descriptor releases the lock
+		if (fd >= 0)
+			::close(fd);
+	}
+
+	CMemoryMapping(const CMemoryMapping&) = delete;
+	CMemoryMapping& operator=(const CMemoryMapping&) = delete;
+
+	CMemoryMapping(CMemoryMapping&& other) noexcept
+		: pData(std::exchange(other.pData, nullptr)),
+		  size(std::exchange(other.size, 0)),
+		  fd(std::exchange(other.fd, -1))
+	{}
+
+	CMemoryMapping& operator=(CMemoryMapping&& other) noexcept
+	{
+		std::swap(pData, other.pData);
+		std::swap(size, other.size);
+		std::swap(fd, other.fd);
+		return *this;
+	}
+
+	/**
+	 * @brief Resizes the file behind `fd` to `bytes` if `b_resize` and maps all of it.
+	 *
+	 * The descriptor is not closed.
+	 */
+	[[nodiscard]]
+	static TResult Map(const int fd, size_t bytes, const bool b_resize) noexcept
+	{
+		if (b_resize && ::ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+			return std::unexpected(EMappedPoolError::OPEN_FAILED);
+		if (!b_resize)
+		{
+			struct stat status{};
+			if (::fstat(fd, &status) != 0)
+				return std::unexpected(EMappedPoolError::OPEN_FAILED);
+			bytes = static_cast<size_t>(status.st_size);
+		}
+		if (bytes == 0)
+			return std::unexpected(EMappedPoolError::INVALID_HEADER);
+
+		void* pData = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (pData == MAP_FAILED)
+			return std::unexpected(EMappedPoolError::MAPPING_FAILED);
+		CMemoryMapping mapping;
+		mapping.pData = static_cast<std::byte*>(pData);
+		mapping.size = bytes;
+		return mapping;
+	}
+
+	/**
+	 * @brief Opens the file at `path`, or creates (and empties) it if `b_create`, and maps it, see `Map`.
+	 *
+	 * Takes an exclusive `flock` before touching the file, so a file already mapped by another
+	 * `MapFile`, in this or another process, is neither truncated nor mapped twice.
+	 *
+	 * @return The mapping, or `OPEN_FAILED`/`LOCKED`/`MAPPING_FAILED`/`INVALID_HEADER`.
+	 */
+	[[nodiscard]]
+	static TResult MapFile(const std::filesystem::path& path, const size_t bytes, const bool b_create) noexcept
+	{
+		const int flags = b_create ? O_RDWR | O_CREAT : O_RDWR;
+		const int fd = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+		if (fd < 0)
+			return std::unexpected(EMappedPoolError::OPEN_FAILED);
+		if (::flock(fd, LOCK_EX | LOCK_NB) != 0)
+		{
+			::close(fd);
+			return std::unexpected(EMappedPoolError::LOCKED);
+		}
+		// truncate only under the lock, then grow, so all bytes read as zero
+		if (b_create && ::ftruncate(fd, 0) != 0)
+		{
+			::close(fd);
+			return std::unexpected(EMappedPoolError::OPEN_FAILED);
+		}
+		auto result = Map(fd, bytes, b_create);
+		if (!result.has_value())
+		{
+			::close(fd);
+			return result;
+		}
+		result->fd = fd;
+		return result;
+	}
+
+	/** @brief Writes dirty pages back to the file and waits for completion. */
+	[[nodiscard]]
+	bool Sync() const noexcept
+	{
+		return pData == nullptr || ::msync(pData, size, MS_SYNC) == 0;
+	}
+
+	[[nodiscard]]
+	std::byte* Data() const noexcept
+	{
+		return pData;
+	}
+
+	[[nodiscard]]
+	size_t Size() const noexcept
+	{
+		return size;
+	}
+
+private:
+	std::byte* pData = nullptr;
+	size_t size = 0;
+	/** Descriptor holding the file lock, -1 for mappings made by `Map`. */
+	int fd = -1;
+};
+}
+
+/**
+ * @class CMappedObjectPool
+ * @brief Fixed-size object pool stored in a memory-mapped file.
+ *
+ * The file holds a `CMappedPoolHeader`, one usage flag per slot and the objects:
+ *
+ * | header (64 B) | flags (`Size()` B) | padding | objects (`Size() * sizeof(T)` B) |
+ *
+ * `Open` maps an existing file and validates the header and the usage flags. Only the
+ * flags (one byte per slot) are scanned, the objects are neither rebuilt nor read, so even
+ * a multi-GB pool is available again within milliseconds, and object pages are only read
+ * from disk when they are touched. Objects are addressed by slot index, never by
+ * pointer: the mapping may land at a different address after every `Open`.
+ * Changes reach the file through the page cache; call `Flush()` to make them durable.
+ *
+ * ### Example
+ * ```cpp
+ * auto sessions = CMappedObjectPool<CSession>::Open("sessions.pool");
+ * if (!sessions)
+ *     sessions = CMappedObjectPool<CSession>::Create("sessions.pool", 1'000'000);
+ *
+ * size_t id; // persist `id`, not the pointer
+ * if (auto result = sessions->UseNext(id))
+ *     (*result)->userId = userId;
+ * ```
+ *
+ * Not thread-safe. The pool holds an exclusive advisory lock (`flock`) on its file until it
+ * is destroyed, so a second `Create` or `Open` of the same file, from this or another
+ * process, fails with `LOCKED` instead of corrupting the pool.
+ *
+ * @tparam T Object type, must be trivially copyable since it is stored as raw bytes.
+ */
+template <pool_object T>
+	requires std::is_trivially_copyable_v<T>
+class CMappedObjectPool
+{
+public:
+	using TResult = std::expected<T*, EPoolError>;
+	using TResultConst = std::expected<const T*, EPoolError>;
+	using TResultVoid = std::expected<void, EPoolError>;
+	using TResultPool = std::expected<CMappedObjectPool, EMappedPoolError>;
+
+	/**
+	 * @brief Creates (or truncates) the file at `path` and default-constructs `size` slots in it.
+	 * @return The pool, or `OPEN_FAILED`/`LOCKED`/`MAPPING_FAILED`.
+	 */
+	[[nodiscard]]
+	static TResultPool Create(const std::filesystem::path& path, size_t size) noexcept;
+	/**
+	 * @brief Maps the pool file at `path` created by `Create`.
+	 *
+	 * Rejects the file with `INVALID_HEADER` if a usage flag is neither free nor used. The
+	 * object count and the round-robin position in the header are rebuilt from the flags, so
+	 * a pool interrupted between updating a flag and the header opens again.
+	 *
+	 * @return The pool with the objects and occupancy stored in the file, or `OPEN_FAILED`/`LOCKED`/
+	 *         `MAPPING_FAILED`/`INVALID_HEADER`/`VERSION_MISMATCH`/`TYPE_MISMATCH`.
+	 */
+	[[nodiscard]]
+	static TResultPool Open(const std::filesystem::path& path) noexcept;
+
+	/** @brief Returns the size of the file backing a pool of `size` slots. */
+	[[nodiscard]]
+	static constexpr size_t FileSize(size_t size) noexcept;
+
+	/** @brief Takes over the mapping, `other` is left empty: `Size()` and `ObjectsInUse()` return 0. */
+	CMappedObjectPool(CMappedObjectPool&& other) noexcept;
+	/** @brief Exchanges the mappings, the previous one of this pool is unmapped with `other`. */
+	CMappedObjectPool& operator=(CMappedObjectPool&& other) noexcept;
+
+	/** @brief Provides direct, unchecked access to the element at `pos`. */
+	T* operator[](size_t pos) noexcept;
+	/** @brief Provides direct, unchecked read-only access to the element at `pos`. */
+	const T* operator[](size_t pos) const noexcept;
+
+	/**
+	 * @brief Marks a specific slot as *in use* and returns a pointer to the object.
+	 * @return Pointer to the object, or `OUT_OF_RANGE`/`ALREADY_IN_USE`.
+	 */
+	[[nodiscard]]
+	TResult Use(size_t pos) noexcept;
+	/**
+	 * @brief Finds the next free slot after the previously used one and marks it as *in use*.
+	 *
+	 * @param[out] found_pos Receives the index of the activated slot.
+	 * @return Pointer to the object, or `FULL` if no slot is free.
+	 */
+	[[nodiscard]]
+	TResult UseNext(size_t& found_pos) noexcept;
+	/**
+	 * @brief Marks the given slot as *unused* and resets the object with `T()`.
+	 * @return Empty `expected` on success, or `OUT_OF_RANGE`/`ALREADY_UNUSED`.
+	 */
+	TResultVoid UnUse(size_t pos) noexcept;
+	/** @brief Returns a pointer to the object at `pos` if it is in use, or `OUT_OF_RANGE`/`NOT_IN_USE`. */
+	[[nodiscard]]
+	TResult Get(size_t pos) noexcept;
+	/** @brief Returns a pointer to the object at `pos` if it is in use, or `OUT_OF_RANGE`/`NOT_IN_USE`. */
+	[[nodiscard]]
+	TResultConst Get(size_t pos) const noexcept;
+	/** @brief Checks whether the object at `pos` is active. */
+	[[nodiscard]]
+	bool IsInUse(size_t pos) const noexcept;
+
+	/** @brief Calls `func(T&)` for every active object in slot order. */
+	template <typename TFunc>
+	void ForEachActive(TFunc&& func);
+	/** @brief Calls `func(const T&)` for every active object in slot order. */
+	template <typename TFunc>
+	void ForEachActive(TFunc&& func) const;
+
+	/**
+	 * @brief Writes all changes back to the file and waits until they are stored.
+	 * @return Empty `expected` on success, or `SYNC_FAILED`.
+	 */
+	[[nodiscard]]
+	std::expected<void, EMappedPoolError> Flush() const noexcept;
+
+	/** @brief Returns the total number of slots in the pool. */
+	[[nodiscard]]
+	size_t Size() const noexcept;
+	/** @brief Returns the number of currently active (used) objects. */
+	[[nodiscard]]
+	size_t ObjectsInUse() const noexcept;
+
+protected:
+	/** @brief Space reserved for `CMappedPoolHeader`, keeps the flags cache-line aligned. */
+	static constexpr size_t HEADER_SIZE = Detail::CACHE_LINE_SIZE;
+	static_assert(sizeof(CMappedPoolHeader) <= HEADER_SIZE);
+	/** @brief Alignment of the object array within the file. */
+	static constexpr size_t OBJECTS_ALIGNMENT = std::max(alignof(T), Detail::CACHE_LINE_SIZE);
+
+	explicit CMappedObjectPool(Detail::CMemoryMapping&& memory) noexcept;
+
+	/** @brief Returns the file offset of the object array of a pool with `size` slots. */
+	[[nodiscard]]
+	static constexpr size_t ObjectsOffset(size_t size) noexcept;
+
+	[[nodiscard]]
+	CMappedPoolHeader& Header() const noexcept;
+	[[nodiscard]]
+	uint8_t* Flags() const noexcept;
+	[[nodiscard]]
+	T* Object(size_t pos) const noexcept;
+
+	Detail::CMemoryMapping mapping;
+	size_t poolSize = 0;
+};
+
+// implementation
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CMappedObjectPool<T>::CMappedObjectPool(Detail::CMemoryMapping&& memory) noexcept
+	: mapping(std::move(memory))
+{
+	poolSize = static_cast<size_t>(Header().capacity);
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CMappedObjectPool<T>::CMappedObjectPool(CMappedObjectPool&& other) noexcept
+	: mapping(std::move(other.mapping)),
+	  poolSize(std::exchange(other.poolSize, 0))
+{}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CMappedObjectPool<T>& CMappedObjectPool<T>::operator=(CMappedObjectPool&& other) noexcept
+{
+	mapping = std::move(other.mapping);
+	std::swap(poolSize, other.poolSize);
+	return *this;
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CMappedObjectPool<T>::TResultPool CMappedObjectPool<T>::Create(const std::filesystem::path& path, const size_t size) noexcept
+{
+	auto memory = Detail::CMemoryMapping::MapFile(path, FileSize(size), true);
+	if (!memory.has_value())
+		return std::unexpected(memory.error());
+
+	// the file was truncated, so all flags are already `FLAG_FREE`
+	::new(memory->Data()) CMappedPoolHeader{
+		.magic = CMappedPoolHeader::MAGIC,
+		.version = CMappedPoolHeader::VERSION,
+		.typeSize = static_cast<uint32_t>(sizeof(T)),
+		.typeAlign = static_cast<uint32_t>(alignof(T)),
+		.reserved = 0,
+		.capacity = size,
+		.objectsInUse = 0,
+		.nextIdx = 0
+	};
+	std::byte* pObjects = memory->Data() + ObjectsOffset(size);
+	for (size_t pos = 0; pos < size; ++pos)
+		::new(pObjects + pos * sizeof(T)) T();
+	return CMappedObjectPool(std::move(*memory));
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CMappedObjectPool<T>::TResultPool CMappedObjectPool<T>::Open(const std::filesystem::path& path) noexcept
+{
+	auto memory = Detail::CMemoryMapping::MapFile(path, 0, false);
+	if (!memory.has_value())
+		return std::unexpected(memory.error());
+	if (memory->Size() < HEADER_SIZE)
+		return std::unexpected(EMappedPoolError::INVALID_HEADER);
+
+	auto* pHeader = std::launder(reinterpret_cast<CMappedPoolHeader*>(memory->Data()));
+	if (pHeader->magic != CMappedPoolHeader::MAGIC)
+		return std::unexpected(EMappedPoolError::INVALID_HEADER);
+	if (pHeader->version != CMappedPoolHeader::VERSION)
+		return std::unexpected(EMappedPoolError::VERSION_MISMATCH);
+	if (pHeader->typeSize != sizeof(T) || pHeader->typeAlign != alignof(T))
+		return std::unexpected(EMappedPoolError::TYPE_MISMATCH);
+	// checked before computing the file size, which could overflow for a corrupt capacity
+	const auto capacity = static_cast<size_t>(pHeader->capacity);
+	if (capacity > (memory->Size() - HEADER_SIZE) / sizeof(T)
+		|| FileSize(capacity) != memory->Size())
+		return std::unexpected(EMappedPoolError::INVALID_HEADER);
+
+	// a foreign or damaged file leaves other flag values behind
+	const auto* pFlags = reinterpret_cast<const uint8_t*>(memory->Data() + HEADER_SIZE);
+	size_t used = 0;
+	bool bValidFlags = true;
+	for (size_t pos = 0; pos < capacity; ++pos)
+	{
+		used += pFlags[pos] == Detail::FLAG_USED;
+		bValidFlags &= pFlags[pos] == Detail::FLAG_FREE || pFlags[pos] == Detail::FLAG_USED;
+	}
+	if (!bValidFlags)
+		return std::unexpected(EMappedPoolError::INVALID_HEADER);
+
+	// a crash between storing a flag and the header leaves stale counters, the flags are authoritative
+	pHeader->objectsInUse = used;
+	if (pHeader->nextIdx >= capacity)
+		pHeader->nextIdx = 0;
+	return CMappedObjectPool(std::move(*memory));
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+constexpr size_t CMappedObjectPool<T>::ObjectsOffset(const size_t size) noexcept
+{
+	return (HEADER_SIZE + size + OBJECTS_ALIGNMENT - 1) / OBJECTS_ALIGNMENT * OBJECTS_ALIGNMENT;
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+constexpr size_t CMappedObjectPool<T>::FileSize(const size_t size) noexcept
+{
+	return ObjectsOffset(size) + size * sizeof(T);
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+T* CMappedObjectPool<T>::operator[](const size_t pos) noexcept
+{
+	return Object(pos);
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+const T* CMappedObjectPool<T>::operator[](const size_t pos) const noexcept
+{
+	return Object(pos);
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CMappedObjectPool<T>::TResult CMappedObjectPool<T>::Use(const size_t pos) noexcept
+{
+	if (pos >= poolSize)
+		return std::unexpected(EPoolError::OUT_OF_RANGE);
+	if (Flags()[pos] != Detail::FLAG_FREE)
+		return std::unexpected(EPoolError::ALREADY_IN_USE);
+
+	Flags()[pos] = Detail::FLAG_USED;
+	Header().objectsInUse++;
+	return Object(pos);
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CMappedObjectPool<T>::TResult CMappedObjectPool<T>::UseNext(size_t& found_pos) noexcept
+{
+	if (poolSize == 0)
+		return std::unexpected(EPoolError::FULL);
+	CMappedPoolHeader& header = Header();
+	const size_t pos = Detail::FindFlagWrapped(Flags(), poolSize, static_cast<size_t>(header.nextIdx), Detail::FLAG_FREE);
+	if (pos == poolSize)
+		return std::unexpected(EPoolError::FULL);
+
+	Flags()[pos] = Detail::FLAG_USED;
+	found_pos = pos;
+	header.nextIdx = pos + 1 < poolSize ? pos + 1 : 0;
+	header.objectsInUse++;
+	return Object(pos);
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CMappedObjectPool<T>::TResultVoid CMappedObjectPool<T>::UnUse(const size_t pos) noexcept
+{
+	if (pos >= poolSize)
+		return std::unexpected(EPoolError::OUT_OF_RANGE);
+	if (Flags()[pos] != Detail::FLAG_USED)
+		return std::unexpected(EPoolError::ALREADY_UNUSED);
+
+	::new(Object(pos)) T();
+	Flags()[pos] = Detail::FLAG_FREE;
+	Header().objectsInUse--;
+	return {};
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CMappedObjectPool<T>::TResult CMappedObjectPool<T>::Get(const size_t pos) noexcept
+{
+	if (pos >= poolSize)
+		return std::unexpected(EPoolError::OUT_OF_RANGE);
+	if (Flags()[pos] != Detail::FLAG_USED)
+		return std::unexpected(EPoolError::NOT_IN_USE);
+	return Object(pos);
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CMappedObjectPool<T>::TResultConst CMappedObjectPool<T>::Get(const size_t pos) const noexcept
+{
+	if (pos >= poolSize)
+		return std::unexpected(EPoolError::OUT_OF_RANGE);
+	if (Flags()[pos] != Detail::FLAG_USED)
+		return std::unexpected(EPoolError::NOT_IN_USE);
+	return Object(pos);
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+bool CMappedObjectPool<T>::IsInUse(const size_t pos) const noexcept
+{
+	return pos < poolSize && Flags()[pos] == Detail::FLAG_USED;
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+template <typename TFunc>
+void CMappedObjectPool<T>::ForEachActive(TFunc&& func)
+{
+	if (poolSize == 0)
+		return;
+	const uint8_t* flags = Flags();
+	for (size_t pos = Detail::FindFlag(flags, 0, poolSize, Detail::FLAG_USED); pos < poolSize;
+	     pos = Detail::FindFlag(flags, pos + 1, poolSize, Detail::FLAG_USED))
+		func(*Object(pos));
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+template <typename TFunc>
+void CMappedObjectPool<T>::ForEachActive(TFunc&& func) const
+{
+	if (poolSize == 0)
+		return;
+	const uint8_t* flags = Flags();
+	for (size_t pos = Detail::FindFlag(flags, 0, poolSize, Detail::FLAG_USED); pos < poolSize;
+	     pos = Detail::FindFlag(flags, pos + 1, poolSize, Detail::FLAG_USED))
+		func(std::as_const(*Object(pos)));
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+std::expected<void, EMappedPoolError> CMappedObjectPool<T>::Flush() const noexcept
+{
+	if (!mapping.Sync())
+		return std::unexpected(EMappedPoolError::SYNC_FAILED);
+	return {};
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+size_t CMappedObjectPool<T>::Size() const noexcept
+{
+	return poolSize;
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+size_t CMappedObjectPool<T>::ObjectsInUse() const noexcept
+{
+	// a moved-from pool has no header
+	return mapping.Data() != nullptr ? static_cast<size_t>(Header().objectsInUse) : 0;
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CMappedPoolHeader& CMappedObjectPool<T>::Header() const noexcept
+{
+	return *std::launder(reinterpret_cast<CMappedPoolHeader*>(mapping.Data()));
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+uint8_t* CMappedObjectPool<T>::Flags() const noexcept
+{
+	return reinterpret_cast<uint8_t*>(mapping.Data() + HEADER_SIZE);
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+T* CMappedObjectPool<T>::Object(const size_t pos) const noexcept
+{
+	return std::launder(reinterpret_cast<T*>(mapping.Data() + ObjectsOffset(poolSize)) + pos);
+}
+}
@@ -4,14 +4,31 @@
 // Author: Daniel Contu (Migos) — https://github.com/AbsintheScripting
 // -----------------------------------------------------------------------------
 #pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <execution>
 #include <expected>
+#include <iterator>
 #include <memory>
 #include <new>
+#include <numeric>
+#include <span>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
 namespace ObjectPool
 {
 // Error handling with std::expected
@@ -48,624 +65,3115 @@ constexpr const char* ToString(const EPoolError& error) noexcept
 	}
 }
 
+/**
+ * @brief Selects which free slot `UseNext*` hands out.
+ *
+ * - `ROUND_ROBIN` — the next free slot after the previously used one (wrapping around).
+ *   Cheapest bookkeeping, but the active objects drift through the whole pool.
+ * - `LOWEST_FREE` — the free slot with the lowest index, keeping the active objects in a
+ *   dense prefix for faster iteration.
+ * - `MOST_RECENTLY_FREED` — the slot released last (LIFO), whose object is most likely
+ *   still in cache. Kept in an intrusive doubly linked free list, so every operation is O(1).
+ */
+enum class EAllocPolicy : uint8_t
+{
+	ROUND_ROBIN,
+	LOWEST_FREE,
+	MOST_RECENTLY_FREED
+};
+
 // Type constraints
 template <typename T>
 concept pool_object = std::default_initializable<T>;
 
 /**
- * @class CObjectPool
- * @brief Deterministic, fixed-capacity pool for object reuse with explicit lifetime control.
+ * @class CLogHistogram
+ * @brief Fixed-size histogram with power-of-two buckets.
  *
- * `CObjectPool` manages a contiguous, pre-allocated collection of objects with type `T`.
- * Each slot can be marked as *in use* or *free* and (re)constructed in-place without
- * performing any dynamic allocations. This design avoids heap fragmentation and ensures
- * consistent performance in real-time or game-engine scenarios.
+ * Bucket `0` counts the value `0`, bucket `k` counts values in `[2^(k-1), 2^k)`.
+ * Recording is a `bit_width` and an increment, so it is cheap enough for hot paths
+ * and never allocates.
+ */
+class CLogHistogram
+{
+public:
+	static constexpr size_t BUCKET_COUNT = 65;
+
+	/** @brief Adds `value` to its bucket. */
+	void Record(const uint64_t value) noexcept
+	{
+		++buckets[std::bit_width(value)];
+		++count;
+	}
+
+	/** @brief Returns the number of recorded values in `bucket`. */
+	[[nodiscard]]
+	uint64_t BucketCount(const size_t bucket) const noexcept
+	{
+		return bucket < BUCKET_COUNT ? buckets[bucket] : 0;
+	}
+
+	/** @brief Returns the smallest value counted by `bucket`. */
+	[[nodiscard]]
+	static constexpr uint64_t BucketLowerBound(const size_t bucket) noexcept
+	{
+		return bucket == 0 ? 0 : uint64_t{1} << (bucket - 1);
+	}
+
+	/** @brief Returns the largest value counted by `bucket`. */
+	[[nodiscard]]
+	static constexpr uint64_t BucketUpperBound(const size_t bucket) noexcept
+	{
+		return bucket == 0 ? 0 : ~uint64_t{0} >> (64 - bucket);
+	}
+
+	/** @brief Returns the total number of recorded values. */
+	[[nodiscard]]
+	uint64_t Count() const noexcept
+	{
+		return count;
+	}
+
+	/**
+	 * @brief Returns an upper bound for the given quantile.
+	 *
+	 * @param quantile Value in `[0, 1]`, e.g. `0.99` for the 99th percentile.
+	 * @return Upper bound of the bucket containing the quantile, or `0` if nothing was recorded.
+	 *
+	 * The result is exact to within a factor of two, which is what the bucket layout allows.
+	 */
+	[[nodiscard]]
+	uint64_t Percentile(const double quantile) const noexcept
+	{
+		if (count == 0)
+			return 0;
+		// nearest-rank method: smallest bucket covering `quantile * count` values
+		const auto covered = static_cast<uint64_t>(std::ceil(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(count)));
+		const uint64_t rank = std::max<uint64_t>(covered, 1) - 1;
+		uint64_t seen = 0;
+		for (size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+		{
+			seen += buckets[bucket];
+			if (seen > rank)
+				return BucketUpperBound(bucket);
+		}
+		return BucketUpperBound(BUCKET_COUNT - 1);
+	}
+
+	/** @brief Clears all buckets. */
+	void Reset() noexcept
+	{
+		buckets.fill(0);
+		count = 0;
+	}
+
+private:
+	std::array<uint64_t, BUCKET_COUNT> buckets{};
+	uint64_t count = 0;
+};
+
+/**
+ * @brief Requirements for the statistics policy of `CObjectPool`.
  *
- * The class uses `std::expected` to report recoverable errors such as invalid indices
- * or attempts to use an already occupied slot — making the API fully `noexcept` while
- * preserving expressive error semantics.
+ * - `OnAcquire(objects_in_use)` — a slot was activated, receives the new number of used slots.
+ * - `OnRelease()` — a slot was returned via `UnUse`.
+ * - `OnScan(scanned)` — a `UseNext*` search finished after inspecting `scanned` usage flags,
+ *   reported for every `EAllocPolicy`.
+ * - `OnFull()` — a `UseNext*` or `UseNear` search failed with `EPoolError::FULL`.
+ */
+template <typename TStats>
+concept pool_stats = std::default_initializable<TStats> && requires(TStats stats, size_t value)
+{
+	stats.OnAcquire(value);
+	stats.OnRelease();
+	stats.OnScan(value);
+	stats.OnFull();
+};
+
+/**
+ * @class CNoPoolStats
+ * @brief Default statistics policy which records nothing.
  *
- * ### Design principles
- * - **Deterministic:** no heap allocations after construction.
- * - **Safe:** type-checked at compile time via concept (`std::default_initializable`).
- * - **Explicit lifetime control:** use/return objects manually (`Use*` / `UnUse`).
- * - **STL-compatible:** provides random access via `operator[]` and iteration
- *   over active elements through `begin()` / `end()`.
- * - **Header-only and noexcept-correct:** zero dependencies beyond the C++ standard library.
+ * All hooks are empty and the member is declared `[[no_unique_address]]`,
+ * so the statistics are compiled out completely.
+ */
+struct CNoPoolStats
+{
+	void OnAcquire(size_t) noexcept {}
+	void OnRelease() noexcept {}
+	void OnScan(size_t) noexcept {}
+	void OnFull() noexcept {}
+};
+
+/**
+ * @class CPoolStats
+ * @brief Statistics policy for capacity planning.
  *
- * ### Typical usage
+ * Records the high-water mark of used slots, acquire/release totals, the number of
+ * `FULL` failures and a histogram of how many usage flags each `UseNext*` call inspected.
+ * Blocks skipped via the block summary aren't counted, so the histogram shows the
+ * actual search work under every allocation policy.
+ *
+ * ### Example
  * ```cpp
- * CObjectPool<CEnemy> enemies(128); // preallocate 128 enemies
+ * CObjectPool<CEnemy, CPoolStats> enemies(128);
+ * // ...
+ * const auto& stats = enemies.Stats();
+ * std::println("peak {} / {}, p99 scan {}", stats.PeakObjectsInUse(), enemies.Size(),
+ *              stats.ScanHistogram().Percentile(0.99));
+ * ```
+ */
+class CPoolStats
+{
+public:
+	void OnAcquire(const size_t objects_in_use) noexcept
+	{
+		++acquires;
+		peakObjectsInUse = std::max(peakObjectsInUse, objects_in_use);
+	}
+
+	void OnRelease() noexcept
+	{
+		++releases;
+	}
+
+	void OnScan(const size_t scanned) noexcept
+	{
+		scanHistogram.Record(scanned);
+	}
+
+	void OnFull() noexcept
+	{
+		++fullFailures;
+	}
+
+	/** @brief Returns the highest number of simultaneously used slots. */
+	[[nodiscard]]
+	size_t PeakObjectsInUse() const noexcept
+	{
+		return peakObjectsInUse;
+	}
+
+	/** @brief Returns the number of successful `Use*` calls. */
+	[[nodiscard]]
+	uint64_t Acquires() const noexcept
+	{
+		return acquires;
+	}
+
+	/** @brief Returns the number of successful `UnUse` calls. */
+	[[nodiscard]]
+	uint64_t Releases() const noexcept
+	{
+		return releases;
+	}
+
+	/** @brief Returns the number of `UseNext*` calls which failed with `EPoolError::FULL`. */
+	[[nodiscard]]
+	uint64_t FullFailures() const noexcept
+	{
+		return fullFailures;
+	}
+
+	/** @brief Returns the histogram of usage flags inspected per `UseNext*` call. */
+	[[nodiscard]]
+	const CLogHistogram& ScanHistogram() const noexcept
+	{
+		return scanHistogram;
+	}
+
+	/** @brief Clears all counters, e.g. at the start of a measurement window. */
+	void Reset() noexcept
+	{
+		peakObjectsInUse = 0;
+		acquires = 0;
+		releases = 0;
+		fullFailures = 0;
+		scanHistogram.Reset();
+	}
+
+private:
+	size_t peakObjectsInUse = 0;
+	uint64_t acquires = 0;
+	uint64_t releases = 0;
+	uint64_t fullFailures = 0;
+	CLogHistogram scanHistogram;
+};
+
+/**
+ * @brief Policies with a user-declared constructor taking `size_t` receive the pool capacity.
  *
- * size_t idx;
- * if (auto result = enemies.UseNext(idx); result.has_value()) {
- *     CEnemy* pEnemy = result.value();
- *     pEnemy->SpawnAt(position);
- * } else {
- *     std::cerr << "Enemy pool full: " << ToString(result.error()) << "\n";
- * }
+ * Aggregates are excluded, otherwise their first member would be initialized with the capacity.
+ */
+template <typename TPolicy>
+concept capacity_constructible = std::constructible_from<TPolicy, size_t> && !std::is_aggregate_v<TPolicy>;
+
+/**
+ * @brief Requirements for the observer policy of `CObjectPool`.
  *
- * for (auto& enemy : enemies)
- *     enemy.Update();
+ * - `OnUse(idx)` — slot `idx` was activated by `Use`, `UseNext*` or `UseNear`.
+ * - `OnUnUse(idx)` — slot `idx` was returned via `UnUse`.
+ * - `OnFull()` — a `UseNext*` or `UseNear` search failed with `EPoolError::FULL`.
+ * - `OnReplace(idx)` — the object in slot `idx` was reconstructed,
+ *   this includes the reconstruction done by `UnUse` and `UseNextReplace`.
  *
- * enemies.UnUse(idx); // mark slot free and reset object
+ * Callbacks are invoked after the pool state has been updated and must not throw.
+ * Observers may additionally provide `OnRelocate(from, to)`, called by `Compact`
+ * when the object in use at `from` was moved to `to` (see `relocation_observer`),
+ * and `OnGet(idx)`, called by the mutable `Get` (see `access_observer`).
+ * Observers with a constructor taking `size_t` are constructed with the pool capacity,
+ * so they can pre-allocate per-slot state (see `capacity_constructible`).
+ */
+template <typename TObserver>
+concept pool_observer = (std::default_initializable<TObserver> || capacity_constructible<TObserver>)
+	&& requires(TObserver observer, size_t idx)
+{
+	observer.OnUse(idx);
+	observer.OnUnUse(idx);
+	observer.OnFull();
+	observer.OnReplace(idx);
+};
+
+/** @brief Observers which want to know about the moves done by `CObjectPool::Compact`. */
+template <typename TObserver>
+concept relocation_observer = requires(TObserver observer, size_t idx)
+{
+	observer.OnRelocate(idx, idx);
+};
+
+/** @brief Observers which want to know when an object is handed out for writing by `CObjectPool::Get`. */
+template <typename TObserver>
+concept access_observer = requires(TObserver observer, size_t idx)
+{
+	observer.OnGet(idx);
+};
+
+/**
+ * @class CNoPoolObserver
+ * @brief Default observer policy which ignores all events.
+ *
+ * Like `CNoPoolStats`, it is empty and stored `[[no_unique_address]]`,
+ * so every callback inlines to nothing.
+ *
+ * ### Custom observer
+ * ```cpp
+ * struct CTraceObserver
+ * {
+ *     void OnUse(size_t idx) noexcept { TRACE_BEGIN("slot", idx); }
+ *     void OnUnUse(size_t idx) noexcept { TRACE_END("slot", idx); }
+ *     void OnFull() noexcept { TRACE_INSTANT("pool full"); }
+ *     void OnReplace(size_t) noexcept {}
+ * };
+ *
+ * CObjectPool<CEnemy, CNoPoolStats, CTraceObserver> enemies(128);
  * ```
+ */
+struct CNoPoolObserver
+{
+	void OnUse(size_t) noexcept {}
+	void OnUnUse(size_t) noexcept {}
+	void OnFull() noexcept {}
+	void OnReplace(size_t) noexcept {}
+};
+
+/** @brief Percentiles of slot hold times reported by `CHoldTimeObserver::Summary()`. */
+struct CHoldTimeSummary
+{
+	uint64_t count = 0;
+	std::chrono::nanoseconds p50{0};
+	std::chrono::nanoseconds p90{0};
+	std::chrono::nanoseconds p99{0};
+	std::chrono::nanoseconds p999{0};
+	std::chrono::nanoseconds max{0};
+};
+
+/**
+ * @class CHoldTimeObserver
+ * @brief Observer policy which measures how long slots stay in use.
  *
- * ### Thread safety
- * Not thread-safe. If used across threads, synchronize externally.
+ * Every `Use*` stores a timestamp for the slot, the matching `UnUse` records the
+ * elapsed time in a `CLogHistogram` (nanoseconds, power-of-two buckets).
+ * Per-slot timestamps are allocated once with the pool capacity.
  *
- * @tparam T Type stored in the pool. Must satisfy `std::default_initializable`.
+ * ### Example
+ * ```cpp
+ * CObjectPool<CConnection, CNoPoolStats, CHoldTimeObserver<>> connections(64);
+ * // ...
+ * const auto summary = connections.Observer().Summary();
+ * std::println("p99 hold time: {}", summary.p99);
+ * ```
+ *
+ * @tparam TClock Clock providing `now()`, e.g. a TSC based clock for lower overhead.
+ *                Defaults to `std::chrono::steady_clock`.
  */
-template <pool_object T>
-class CObjectPool
+template <typename TClock = std::chrono::steady_clock>
+class CHoldTimeObserver
 {
 public:
+	explicit CHoldTimeObserver(const size_t size)
+		: acquiredAt(size)
+	{}
+
+	void OnUse(const size_t idx) noexcept
+	{
+		acquiredAt[idx] = TClock::now();
+	}
+
+	void OnUnUse(const size_t idx) noexcept
+	{
+		const auto holdTime = std::chrono::duration_cast<std::chrono::nanoseconds>(TClock::now() - acquiredAt[idx]);
+		const auto nanoseconds = static_cast<uint64_t>(std::max<int64_t>(holdTime.count(), 0));
+		histogram.Record(nanoseconds);
+		maxHoldTime = std::max(maxHoldTime, nanoseconds);
+	}
+
+	void OnFull() noexcept {}
+	void OnReplace(size_t) noexcept {}
+
+	void OnRelocate(const size_t from, const size_t to) noexcept
+	{
+		acquiredAt[to] = acquiredAt[from];
+	}
+
+	/** @brief Returns the histogram of hold times in nanoseconds. */
+	[[nodiscard]]
+	const CLogHistogram& Histogram() const noexcept
+	{
+		return histogram;
+	}
+
 	/**
-	 * @class CObjectPool::CIterator
-	 * @brief Forward iterator that traverses only *used* elements in the pool.
-	 *
-	 * This iterator provides STL-compatible traversal over active elements of
-	 * a `CObjectPool<T>`. It skips all slots marked as unused, allowing seamless
-	 * integration with range-based `for` loops, standard algorithms, and C++23
-	 * ranges library operations.
-	 *
-	 * The iterator satisfies the **ForwardIterator** requirements and supports
-	 * comparison, dereference, and increment operations. It is lightweight and
-	 * non-owning — it merely references the parent pool and tracks the current index.
-	 *
-	 * ### Example
-	 * ```cpp
-	 * CObjectPool<CParticle> pool(100);
-	 * size_t id;
-	 * (void)pool.UseNext(id); // 0
-	 * (void)pool.UseNext(id); // 1
-	 *
-	 * for (auto& particle : pool)  // implicitly uses CIterator
-	 *     particle.Update(dt); // will only update 0 & 1
-	 * ```
+	 * @brief Returns an upper bound of the given hold time quantile.
 	 *
-	 * ### Design notes
-	 * - Skips unused elements automatically on construction and increment.
-	 * - Works for both const and non-const contexts.
-	 * - Returning by reference allows modification of active objects directly.
-	 * - Safe even when pool is empty (begin == end).
-	 *
-	 * @tparam T Element type stored in the parent `CObjectPool`.
+	 * @param quantile Value in `[0, 1]`, e.g. `0.99` for the 99th percentile.
 	 */
-	class CIterator
+	[[nodiscard]]
+	std::chrono::nanoseconds Percentile(const double quantile) const noexcept
 	{
-	public:
-		static constexpr bool B_BEGIN = true;
-		static constexpr bool B_END = false;
+		const uint64_t upperBound = std::min(histogram.Percentile(quantile), maxHoldTime);
+		return std::chrono::nanoseconds(static_cast<int64_t>(upperBound));
+	}
 
-		// STL conformity
-		using iterator_category = std::forward_iterator_tag;
-		using value_type = T;
-		using difference_type = std::ptrdiff_t;
-		using pointer = T*;
-		using reference = T&;
+	/** @brief Returns the common percentiles of all completed holds. */
+	[[nodiscard]]
+	CHoldTimeSummary Summary() const noexcept
+	{
+		return {
+			.count = histogram.Count(),
+			.p50 = Percentile(0.5),
+			.p90 = Percentile(0.9),
+			.p99 = Percentile(0.99),
+			.p999 = Percentile(0.999),
+			.max = std::chrono::nanoseconds(static_cast<int64_t>(maxHoldTime))
+		};
+	}
 
-		CIterator()
-			: currentPos(0),
-			  pObject(nullptr),
-			  pPool(nullptr)
-		{}
+	/** @brief Clears the recorded hold times, slots currently in use keep their timestamp. */
+	void Reset() noexcept
+	{
+		histogram.Reset();
+		maxHoldTime = 0;
+	}
 
-		CIterator(CObjectPool* p_pool, const bool b_begin)
-			: currentPos(0),
-			  pObject(nullptr),
-			  pPool(p_pool)
-		{
-			// Skip to the first in-use object or set to end sentinel
-			if (b_begin)
-				SkipUnused();
-			else
-				SkipToEnd();
-		}
+private:
+	std::vector<typename TClock::time_point> acquiredAt;
+	CLogHistogram histogram;
+	uint64_t maxHoldTime = 0;
+};
 
-		// Dereference operator
-		reference operator*() const
+/**
+ * @class CDirtyObserver
+ * @brief Observer policy which marks every slot changed since the last `ClearDirty()`.
+ *
+ * A slot becomes dirty on `Use*`, `UnUse`, `Replace`, a mutable `Get`, when `Compact`
+ * moves an object from or to it, or via an explicit `MarkDirty(idx)` after writing through
+ * `operator[]` or an iterator. The bitmap holds one bit per slot, `DirtySlots()` walks the
+ * set bits word by word, so visiting the changes costs O(changed + n / 64).
+ *
+ * ### Example
+ * ```cpp
+ * CObjectPool<CEntity, CNoPoolStats, CDirtyObserver> entities(4096);
+ * // ... per tick
+ * for (const size_t idx : entities.Observer().DirtySlots()) {
+ *     if (entities.IsInUse(idx))
+ *         replication.SendUpdate(idx, *entities[idx]);
+ *     else
+ *         replication.SendRemove(idx);
+ * }
+ * entities.Observer().ClearDirty();
+ * ```
+ */
+class CDirtyObserver
+{
+public:
+	/** @brief Forward iterator over the indices of the dirty slots in ascending order. */
+	class CDirtyIterator
+	{
+	public:
+		// indices are yielded by value, which only allows input iterators in the legacy sense
+		using iterator_concept = std::forward_iterator_tag;
+		using iterator_category = std::input_iterator_tag;
+		using value_type = size_t;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const size_t*;
+		using reference = size_t;
+
+		CDirtyIterator() = default;
+
+		CDirtyIterator(const std::vector<uint64_t>* p_words, const size_t idx)
+			: pWords(p_words),
+			  currentIdx(idx)
 		{
-			return *pObject;
+			SkipClean();
 		}
 
-		// Pointer access operator
-		pointer operator->() const
+		reference operator*() const noexcept
 		{
-			return pObject;
+			return currentIdx;
 		}
 
-		// Pre-increment
-		CIterator& operator++()
+		CDirtyIterator& operator++() noexcept
 		{
-			++currentPos;
-			SkipUnused();
+			++currentIdx;
+			SkipClean();
 			return *this;
 		}
 
-		// Post-increment
-		CIterator operator++(int)
+		CDirtyIterator operator++(int) noexcept
 		{
-			CIterator temp = *this;
+			CDirtyIterator tmp = *this;
 			++(*this);
-			return temp;
-		}
-
-		// Equality comparison
-		bool operator==(const CIterator& other) const
-		{
-			return pObject == other.pObject;
+			return tmp;
 		}
 
-		// Inequality comparison
-		bool operator!=(const CIterator& other) const
+		bool operator==(const CDirtyIterator& other) const noexcept
 		{
-			return pObject != other.pObject;
+			return currentIdx == other.currentIdx;
 		}
 
 	private:
-		size_t currentPos;
-		pointer pObject;
-		CObjectPool* pPool;
+		const std::vector<uint64_t>* pWords = nullptr;
+		size_t currentIdx = 0;
 
-		// Skip unused objects
-		void SkipUnused()
+		// Advance to the next set bit at or after `currentIdx`, or to the end (`words * 64`)
+		void SkipClean() noexcept
 		{
-			const size_t end = pPool->Size();
-			while (currentPos < end && !pPool->IsInUse(currentPos))
+			const size_t wordCount = pWords->size();
+			size_t word = currentIdx / 64;
+			if (word >= wordCount)
+				return;
+			uint64_t bits = (*pWords)[word] & (~uint64_t{0} << (currentIdx % 64));
+			while (bits == 0)
 			{
-				++currentPos;
+				if (++word == wordCount)
+				{
+					currentIdx = wordCount * 64;
+					return;
+				}
+				bits = (*pWords)[word];
 			}
-			pObject = pPool->IsInUse(currentPos) ? (*pPool)[currentPos] : nullptr;
+			currentIdx = word * 64 + static_cast<size_t>(std::countr_zero(bits));
 		}
+	};
 
-		// End iterator points one past the last element (sentinel)
-		void SkipToEnd()
+	/** @brief Range over the dirty slots, returned by `DirtySlots()`. */
+	class CDirtyView
+	{
+	public:
+		explicit CDirtyView(const std::vector<uint64_t>* p_words)
+			: pWords(p_words)
+		{}
+
+		CDirtyIterator begin() const
 		{
-			currentPos = pPool->Size();
-			pObject = nullptr;
+			return CDirtyIterator(pWords, 0);
+		}
+
+		CDirtyIterator end() const
+		{
+			return CDirtyIterator(pWords, pWords->size() * 64);
 		}
+
+	private:
+		const std::vector<uint64_t>* pWords;
 	};
 
-	using TResult = std::expected<T*, EPoolError>;
-	using TResultConst = std::expected<const T*, EPoolError>;
-	using TResultVoid = std::expected<void, EPoolError>;
+	explicit CDirtyObserver(const size_t size)
+		: words((size + 63) / 64)
+	{}
 
-	CObjectPool() = delete;
-	/**
-	 * @brief Constructs the pool and pre-allocates `size` objects.
-	 *
-	 * @param size Maximum number of objects managed by the pool.
-	 *
-	 * With this constructor each element is default-constructed.
-	 * No further allocations occur during usage.
-	 */
-	explicit CObjectPool(size_t size);
-	/**
-	 * @brief Constructs the pool and pre-allocates `size` objects.
-	 *
-	 * @param size Maximum number of objects managed by the pool.
-	 * @param args  Optional arguments forwarded to `T` constructor for all elements.
-	 *
-	 * With this constructor each element is constructed using the provided arguments.
-	 * No further allocations occur during usage.
-	 */
-	template <typename... Args>
-	explicit CObjectPool(size_t size, Args&&... args);
-	~CObjectPool();
+	void OnUse(const size_t idx) noexcept
+	{
+		MarkDirty(idx);
+	}
 
-	// Prevent assignment and pass-by-value (but may be implemented later)
-	CObjectPool(const CObjectPool&) = delete;
-	CObjectPool& operator=(const CObjectPool&) = delete;
-	// disable move operation (but may be implemented later)
-	CObjectPool(const CObjectPool&&) = delete;
-	CObjectPool& operator=(const CObjectPool&&) = delete;
+	void OnUnUse(const size_t idx) noexcept
+	{
+		MarkDirty(idx);
+	}
 
-	/**
-	 * @brief Provides direct, unchecked access to the element at `pos`.
-	 *
-	 * @param pos Slot index (no bounds checking).
-	 * @return Raw pointer to the element.
-	 *
-	 * Use `Get()` when safety is required; use `operator[]` for high-performance access
-	 * when index validity is guaranteed.
-	 */
-	T* operator[](size_t pos) noexcept;
+	void OnFull() noexcept {}
 
-	/**
-	 * @brief Marks a specific slot as *in use* and returns a pointer to the object.
-	 *
-	 * @param pos Index of the slot to activate.
-	 * @return `T*` wrapped in `std::expected` if successful,
-	 *              or an error (`OUT_OF_RANGE`, `ALREADY_IN_USE`) otherwise.
-	 *
-	 * Activating a slot sets its usage flag to true.
-	 * Does not reconstruct the object.
-	 */
+	void OnReplace(const size_t idx) noexcept
+	{
+		MarkDirty(idx);
+	}
+
+	void OnRelocate(const size_t from, const size_t to) noexcept
+	{
+		MarkDirty(from);
+		MarkDirty(to);
+	}
+
+	void OnGet(const size_t idx) noexcept
+	{
+		MarkDirty(idx);
+	}
+
+	/** @brief Marks slot `idx` as changed, e.g. after writing through `operator[]`. */
+	void MarkDirty(const size_t idx) noexcept
+	{
+		words[idx / 64] |= uint64_t{1} << (idx % 64);
+	}
+
+	/** @brief Checks whether slot `idx` changed since the last `ClearDirty()`. */
 	[[nodiscard]]
-	TResult Use(size_t pos) noexcept;
-	/**
-	 * @brief Finds the next free slot and marks it as *in use*.
-	 *
-	 * @param[out] found_pos Receives the index of the activated slot,
-	 *                       or is not changed if the pool is full.
-	 * @return Pointer to the activated object, or `std::unexpected(EPoolError::FULL)`
-	 *         if no free slots remain.
-	 *
-	 * This function performs a linear search from the last inserted objects position
-	 * to find the first available position, ensuring fast fill order.
-	 */
+	bool IsDirty(const size_t idx) const noexcept
+	{
+		return (words[idx / 64] >> (idx % 64)) & 1;
+	}
+
+	/** @brief Returns the number of dirty slots. */
 	[[nodiscard]]
-	TResult UseNext(size_t& found_pos) noexcept;
-	/**
-	 * @brief Finds the next free slot, reconstructs its object, and activates it.
-	 *
-	 * @param[out] found_pos Receives the index of the activated slot,
-	 *                       or is not changed if the pool is full.
-	 * @return Pointer to the activated object, or error (`FULL`) if pool has no free slots.
-	 *
-	 * Equivalent to calling `Replace(index)` followed by `Use(index)`.
-	 */
+	size_t DirtyCount() const noexcept
+	{
+		size_t count = 0;
+		for (const uint64_t word : words)
+			count += static_cast<size_t>(std::popcount(word));
+		return count;
+	}
+
+	/** @brief Returns the indices of all dirty slots, used and free ones. */
 	[[nodiscard]]
-	TResult UseNextReplace(size_t& found_pos) noexcept;
-	/**
-	 * @brief Finds the next free slot, reconstructs its object with new arguments, and activates it.
-	 *
-	 * @param[out] found_pos Receives the index of the activated slot,
-	 *                       or is not changed if the pool is full.
-	 * @param args Arguments forwarded to `T`'s constructor for in-place reconstruction.
-	 * @return Pointer to the activated object, or error (`FULL`) if pool has no free slots.
-	 *
-	 * Equivalent to calling `Replace(index, args...)` followed by `Use(index)`.
-	 */
-	template <typename... Args>
+	CDirtyView DirtySlots() const noexcept
+	{
+		return CDirtyView(&words);
+	}
+
+	/** @brief Marks all slots as clean. */
+	void ClearDirty() noexcept
+	{
+		std::ranges::fill(words, 0);
+	}
+
+private:
+	std::vector<uint64_t> words;
+};
+
+namespace Detail
+{
+/** @brief Assumed size of a cache line, used to keep parallel work chunks apart. */
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @class CCacheLineAllocator
+ * @brief Stateless allocator which aligns every allocation to `CACHE_LINE_SIZE`.
+ *
+ * Lets the owned object storage start on a cache line, so chunk boundaries
+ * which are multiples of a line in bytes fall on line boundaries, too.
+ */
+template <typename T>
+class CCacheLineAllocator
+{
+public:
+	using value_type = T;
+	using is_always_equal = std::true_type;
+
+	static constexpr std::align_val_t ALIGNMENT{std::max(alignof(T), CACHE_LINE_SIZE)};
+
+	CCacheLineAllocator() = default;
+
+	template <typename U>
+	explicit(false) CCacheLineAllocator(const CCacheLineAllocator<U>&) noexcept
+	{}
+
 	[[nodiscard]]
-	TResult UseNextReplace(size_t& found_pos, Args&&... args) noexcept;
-	/**
-	 * @brief Returns a pointer to the object at `index` if it is currently in use.
-	 *
-	 * @param pos Index of the slot to query.
-	 * @return Pointer wrapped in `std::expected`, or error (`OUT_OF_RANGE`, `NOT_IN_USE`).
-	 *
-	 * Safe alternative to `operator[]`, which doesn't check bounds nor usage.
-	 */
+	T* allocate(const size_t count)
+	{
+		return static_cast<T*>(::operator new(count * sizeof(T), ALIGNMENT));
+	}
+
+	void deallocate(T* p_data, size_t) noexcept
+	{
+		::operator delete(p_data, ALIGNMENT);
+	}
+
+	template <typename U>
+	friend bool operator==(const CCacheLineAllocator&, const CCacheLineAllocator<U>&) noexcept
+	{
+		return true;
+	}
+};
+
+/** @brief Values of the per-slot usage flags. */
+inline constexpr uint8_t FLAG_FREE = 0;
+inline constexpr uint8_t FLAG_USED = 1;
+
+/** @brief Number of slots summarized by one bit of `CBlockSummary`, one cache line of flags. */
+inline constexpr size_t BLOCK_SIZE = 64;
+
+/** @brief Returns a process-wide unique pool id, so a snapshot is never compared against the stamps of another pool. */
+inline uint64_t NextPoolId() noexcept
+{
+	static std::atomic<uint64_t> lastId = 0;
+	return lastId.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+/**
+ * @class CBlockSummary
+ * @brief Hierarchical bitmap with one bit per block of `BLOCK_SIZE` slots, e.g. "block has a free slot".
+ *
+ * Level 0 holds one bit per block, every further level one bit per non-zero word of the
+ * level below, up to a single word. `FindFirst`/`FindLast` climb up until a level has a
+ * set bit in the searched direction and descend along the lowest/highest set bits again,
+ * so a search costs O(log64 n) word reads regardless of the occupancy:
+ * three levels cover 16M slots. `Set`/`Clear` only propagate while a word changes
+ * between zero and non-zero.
+ */
+class CBlockSummary
+{
+public:
+	CBlockSummary() = default;
+
+	explicit CBlockSummary(const size_t blocks)
+		: blockCount(blocks)
+	{
+		size_t bits = blocks;
+		do
+		{
+			bits = (bits + 63) / 64;
+			levels.emplace_back(bits);
+		}
+		while (bits > 1);
+	}
+
+	void Set(size_t block) noexcept
+	{
+		for (auto& level : levels)
+		{
+			uint64_t& word = level[block / 64];
+			const bool bWasEmpty = word == 0;
+			word |= uint64_t{1} << (block % 64);
+			if (!bWasEmpty)
+				break;
+			block /= 64;
+		}
+	}
+
+	void Clear(size_t block) noexcept
+	{
+		for (auto& level : levels)
+		{
+			uint64_t& word = level[block / 64];
+			word &= ~(uint64_t{1} << (block % 64));
+			if (word != 0)
+				break;
+			block /= 64;
+		}
+	}
+
 	[[nodiscard]]
-	TResult Get(size_t pos) noexcept;
-	/**
-	 * @brief Returns a pointer to the object at `index` if it is currently in use.
-	 *
-	 * @param pos Index of the slot to query.
-	 * @return Pointer wrapped in `std::expected`, or error (`OUT_OF_RANGE`, `NOT_IN_USE`).
-	 *
-	 * Safe alternative to `operator[]`, which doesn't check bounds nor usage.
-	 */
+	bool Test(const size_t block) const noexcept
+	{
+		return (levels[0][block / 64] >> (block % 64)) & 1;
+	}
+
+	/** @brief Returns the first set block at or after `from`, or `BlockCount()` if there is none. */
 	[[nodiscard]]
-	TResultConst Get(size_t pos) const noexcept;
-	/**
-	 * @brief Checks whether the object at `pos` is active.
-	 *
-	 * @param pos Index of the slot to check.
-	 * @return `true` if slot is in use and within range, otherwise `false`.
-	 */
+	size_t FindFirst(const size_t from) const noexcept
+	{
+		if (from >= blockCount)
+			return blockCount;
+		size_t level = 0;
+		size_t idx = from;
+		while (true)
+		{
+			const size_t word = idx / 64;
+			if (word >= levels[level].size())
+				return blockCount;
+			if (const uint64_t bits = levels[level][word] & (~uint64_t{0} << (idx % 64)); bits != 0)
+			{
+				idx = word * 64 + static_cast<size_t>(std::countr_zero(bits));
+				break;
+			}
+			if (++level == levels.size())
+				return blockCount;
+			idx = word + 1; // continue behind this word one level up
+		}
+		while (level > 0)
+		{
+			--level;
+			idx = idx * 64 + static_cast<size_t>(std::countr_zero(levels[level][idx]));
+		}
+		return idx;
+	}
+
+	/** @brief Returns the last set block before `to`, or `BlockCount()` if there is none. */
 	[[nodiscard]]
-	bool IsInUse(size_t pos) const noexcept;
-	/**
-	 * @brief Marks the given slot as *unused* and reconstructs the object.
-	 *
-	 * @param pos Index to deactivate.
-	 * @return Empty `expected` on success, or error (`OUT_OF_RANGE`, `ALREADY_UNUSED`) otherwise.
-	 *
-	 * Once marked unused, the slot becomes available for subsequent `Use` or `UseNext` calls.
-	 */
-	TResultVoid UnUse(size_t pos) noexcept;
-	/**
-	 * @brief Marks the given slot as *unused* and reconstructs the object.
-	 *
-	 * @param pos Index to deactivate.
-	 * @param args  Optional arguments for reinitializing the element via placement new.
-	 * @return Empty `expected` on success, or error (`OUT_OF_RANGE`, `ALREADY_UNUSED`) otherwise.
-	 *
-	 * Once marked unused, the slot becomes available for subsequent `Use` or `UseNext` calls.
-	 */
-	template <typename... Args>
-	TResultVoid UnUse(size_t pos, Args&&... args) noexcept;
-	/**
-	 * @brief Reconstructs the object at the given index (regardless of usage state).
-	 *
-	 * @param pos Index of the element to reconstruct.
-	 * @return Empty `expected` on success, or `OUT_OF_RANGE` on invalid index.
-	 *
-	 * This operation marks the element as unused.
-	 * It is primarily intended to reset or repopulate the object.
-	 */
+	size_t FindLast(const size_t to) const noexcept
+	{
+		if (to == 0 || blockCount == 0)
+			return blockCount;
+		size_t level = 0;
+		size_t idx = std::min(to, blockCount) - 1;
+		while (true)
+		{
+			const size_t word = idx / 64;
+			const uint64_t mask = ~uint64_t{0} >> (63 - idx % 64);
+			if (const uint64_t bits = levels[level][word] & mask; bits != 0)
+			{
+				idx = word * 64 + static_cast<size_t>(std::bit_width(bits) - 1);
+				break;
+			}
+			if (word == 0 || ++level == levels.size())
+				return blockCount;
+			idx = word - 1; // continue before this word one level up
+		}
+		while (level > 0)
+		{
+			--level;
+			idx = idx * 64 + static_cast<size_t>(std::bit_width(levels[level][idx]) - 1);
+		}
+		return idx;
+	}
+
 	[[nodiscard]]
-	TResultVoid Replace(size_t pos) noexcept;
+	size_t BlockCount() const noexcept
+	{
+		return blockCount;
+	}
+
+private:
+	size_t blockCount = 0;
+	std::vector<std::vector<uint64_t>> levels;
+};
+
+/**
+ * @brief Portable fallback of `FindFlag`.
+ *
+ * On little-endian targets eight flags are compared at once by treating them as one
+ * 64-bit word (SWAR), otherwise it falls back to a byte loop.
+ */
+[[nodiscard]]
+inline size_t FindFlagScalar(const uint8_t* flags, size_t from, const size_t to, const uint8_t value) noexcept
+{
+	if constexpr (std::endian::native == std::endian::little)
+	{
+		constexpr uint64_t LOW_BITS = 0x0101010101010101ull;
+		constexpr uint64_t HIGH_BITS = 0x8080808080808080ull;
+		const uint64_t pattern = LOW_BITS * value;
+		for (; from + sizeof(uint64_t) <= to; from += sizeof(uint64_t))
+		{
+			uint64_t word;
+			std::memcpy(&word, flags + from, sizeof(uint64_t));
+			// bytes equal to `value` become zero, the lowest zero byte sets its high bit exactly
+			const uint64_t difference = word ^ pattern;
+			const uint64_t matches = (difference - LOW_BITS) & ~difference & HIGH_BITS;
+			if (matches != 0)
+				return from + static_cast<size_t>(std::countr_zero(matches)) / 8;
+		}
+	}
+	for (; from < to; ++from)
+	{
+		if (flags[from] == value)
+			return from;
+	}
+	return to;
+}
+
+/**
+ * @brief Returns the index of the first flag in `[from, to)` equal to `value`, or `to` if there is none.
+ *
+ * Compares 32 (AVX2) or 16 (SSE2) flags per instruction using `cmpeq` + `movemask`
+ * and locates the match with a count-trailing-zeros. The remainder, and targets
+ * without these instruction sets, are handled by `FindFlagScalar`.
+ */
+[[nodiscard]]
+inline size_t FindFlag(const uint8_t* flags, size_t from, const size_t to, const uint8_t value) noexcept
+{
+#if defined(__AVX2__)
+	const __m256i pattern256 = _mm256_set1_epi8(static_cast<char>(value));
+	for (; from + 32 <= to; from += 32)
+	{
+		const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(flags + from));
+		const auto matches = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, pattern256)));
+		if (matches != 0)
+			return from + static_cast<size_t>(std::countr_zero(matches));
+	}
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+	const __m128i pattern128 = _mm_set1_epi8(static_cast<char>(value));
+	for (; from + 16 <= to; from += 16)
+	{
+		const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(flags + from));
+		const auto matches = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, pattern128)));
+		if (matches != 0)
+			return from + static_cast<size_t>(std::countr_zero(matches));
+	}
+#endif
+	return FindFlagScalar(flags, from, to, value);
+}
+
+/**
+ * @brief Portable fallback of `FindFlagBackward`.
+ *
+ * Like `FindFlagScalar` it compares eight flags at once on little-endian targets, but uses
+ * the carry-free zero-byte test, because the highest match has to be exact as well.
+ */
+[[nodiscard]]
+inline size_t FindFlagBackwardScalar(const uint8_t* flags, const size_t from, size_t to, const uint8_t value) noexcept
+{
+	const size_t notFound = to;
+	if constexpr (std::endian::native == std::endian::little)
+	{
+		constexpr uint64_t LOW_BITS = 0x0101010101010101ull;
+		constexpr uint64_t LOW_SEVEN_BITS = 0x7F7F7F7F7F7F7F7Full;
+		const uint64_t pattern = LOW_BITS * value;
+		for (; to >= from + sizeof(uint64_t); to -= sizeof(uint64_t))
+		{
+			uint64_t word;
+			std::memcpy(&word, flags + to - sizeof(uint64_t), sizeof(uint64_t));
+			const uint64_t difference = word ^ pattern;
+			const uint64_t matches = ~(((difference & LOW_SEVEN_BITS) + LOW_SEVEN_BITS) | difference | LOW_SEVEN_BITS);
+			if (matches != 0)
+				return to - sizeof(uint64_t) + static_cast<size_t>(std::bit_width(matches) - 1) / 8;
+		}
+	}
+	while (to > from)
+	{
+		if (flags[--to] == value)
+			return to;
+	}
+	return notFound;
+}
+
+/**
+ * @brief Returns the index of the last flag in `[from, to)` equal to `value`, or `to` if there is none.
+ *
+ * Mirror image of `FindFlag`: scans from the back with the same `cmpeq` + `movemask`
+ * approach and locates the match with a count-leading-zeros.
+ */
+[[nodiscard]]
+inline size_t FindFlagBackward(const uint8_t* flags, const size_t from, size_t to, const uint8_t value) noexcept
+{
+	const size_t notFound = to;
+#if defined(__AVX2__)
+	const __m256i pattern256 = _mm256_set1_epi8(static_cast<char>(value));
+	for (; to >= from + 32; to -= 32)
+	{
+		const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(flags + to - 32));
+		const auto matches = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, pattern256)));
+		if (matches != 0)
+			return to - 32 + static_cast<size_t>(std::bit_width(matches) - 1);
+	}
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+	const __m128i pattern128 = _mm_set1_epi8(static_cast<char>(value));
+	for (; to >= from + 16; to -= 16)
+	{
+		const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(flags + to - 16));
+		const auto matches = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, pattern128)));
+		if (matches != 0)
+			return to - 16 + static_cast<size_t>(std::bit_width(matches) - 1);
+	}
+#endif
+	const size_t pos = FindFlagBackwardScalar(flags, from, to, value);
+	return pos != to ? pos : notFound;
+}
+
+/**
+ * @brief Circular variant of `FindFlag`, searches `[start, size)` first and then wraps to `[0, start)`.
+ *
+ * @return Index of the first flag equal to `value` in ring order, or `size` if there is none.
+ *
+ * Splitting the ring into two linear segments avoids an integer division per inspected flag.
+ */
+[[nodiscard]]
+inline size_t FindFlagWrapped(const uint8_t* flags, const size_t size, const size_t start, const uint8_t value) noexcept
+{
+	if (const size_t pos = FindFlag(flags, start, size, value); pos != size)
+		return pos;
+	const size_t pos = FindFlag(flags, 0, start, value);
+	return pos != start ? pos : size;
+}
+}
+
+/**
+ * @class CObjectPool
+ * @brief Deterministic, fixed-capacity pool for object reuse with explicit lifetime control.
+ *
+ * `CObjectPool` manages a contiguous, pre-allocated collection of objects with type `T`.
+ * Each slot can be marked as *in use* or *free* and (re)constructed in-place without
+ * performing any dynamic allocations. This design avoids heap fragmentation and ensures
+ * consistent performance in real-time or game-engine scenarios.
+ *
+ * The class uses `std::expected` to report recoverable errors such as invalid indices
+ * or attempts to use an already occupied slot — making the API fully `noexcept` while
+ * preserving expressive error semantics.
+ *
+ * ### Design principles
+ * - **Deterministic:** no heap allocations after construction.
+ * - **Safe:** type-checked at compile time via concept (`std::default_initializable`).
+ * - **Explicit lifetime control:** use/return objects manually (`Use*` / `UnUse`).
+ * - **STL-compatible:** provides random access via `operator[]` and iteration
+ *   over active elements through `begin()` / `end()`.
+ * - **Header-only and noexcept-correct:** zero dependencies beyond the C++ standard library.
+ *
+ * ### Typical usage
+ * ```cpp
+ * CObjectPool<CEnemy> enemies(128); // preallocate 128 enemies
+ *
+ * size_t idx;
+ * if (auto result = enemies.UseNext(idx); result.has_value()) {
+ *     CEnemy* pEnemy = result.value();
+ *     pEnemy->SpawnAt(position);
+ * } else {
+ *     std::cerr << "Enemy pool full: " << ToString(result.error()) << "\n";
+ * }
+ *
+ * for (auto& enemy : enemies)
+ *     enemy.Update();
+ *
+ * enemies.UnUse(idx); // mark slot free and reset object
+ * ```
+ *
+ * ### Thread safety
+ * Not thread-safe. If used across threads, synchronize externally.
+ *
+ * @tparam T Type stored in the pool. Must satisfy `std::default_initializable`.
+ * @tparam TStats Statistics policy, see `CPoolStats`. Defaults to `CNoPoolStats` (compiled out).
+ * @tparam TObserver Observer policy receiving slot events, see `pool_observer`.
+ *                   Defaults to `CNoPoolObserver` (compiled out).
+ * @tparam ALLOC_POLICY Which free slot `UseNext*` picks, see `EAllocPolicy`.
+ *                      Defaults to `EAllocPolicy::ROUND_ROBIN`.
+ */
+template <pool_object T, pool_stats TStats = CNoPoolStats, pool_observer TObserver = CNoPoolObserver,
+          EAllocPolicy ALLOC_POLICY = EAllocPolicy::ROUND_ROBIN>
+class CObjectPool
+{
+public:
+	/**
+	 * @class CObjectPool::CBasicIterator
+	 * @brief Bidirectional iterator that traverses only *used* elements in the pool.
+	 *
+	 * This iterator provides STL-compatible traversal over active elements of
+	 * a `CObjectPool<T>`. It skips all slots marked as unused, allowing seamless
+	 * integration with range-based `for` loops, standard algorithms, and C++23
+	 * ranges library operations.
+	 *
+	 * The iterator satisfies the **BidirectionalIterator** requirements and supports
+	 * comparison, dereference, increment and decrement operations, so `std::views::reverse`,
+	 * `std::ranges::partition` or `std::ranges::reverse` work on the active elements.
+	 * Random access is not possible, because the distance between two active elements
+	 * depends on the occupancy; use `Slots()` for random access over all slots.
+	 * It is lightweight and non-owning — it merely references the parent pool and tracks the current index.
+	 * Use the aliases `CIterator` and `CConstIterator`.
+	 *
+	 * ### Example
+	 * ```cpp
+	 * CObjectPool<CParticle> pool(100);
+	 * size_t id;
+	 * (void)pool.UseNext(id); // 0
+	 * (void)pool.UseNext(id); // 1
+	 *
+	 * for (auto& particle : pool)  // implicitly uses CIterator
+	 *     particle.Update(dt); // will only update 0 & 1
+	 *
+	 * const auto& readOnly = pool;
+	 * for (const auto& particle : readOnly)  // implicitly uses CConstIterator
+	 *     Draw(particle);
+	 * ```
+	 *
+	 * ### Design notes
+	 * - Skips unused elements automatically on construction, increment and decrement.
+	 * - `CConstIterator` only needs a `const CObjectPool&` and yields `const T&`,
+	 *   so readers never require mutable access to the pool.
+	 * - `CIterator` converts implicitly to `CConstIterator`.
+	 * - Returning by reference allows modification of active objects directly.
+	 * - Safe even when pool is empty (begin == end).
+	 *
+	 * @tparam B_CONST `true` for read-only iteration over a `const CObjectPool`.
+	 */
+	template <bool B_CONST>
+	class CBasicIterator
+	{
+	public:
+		static constexpr bool B_BEGIN = true;
+		static constexpr bool B_END = false;
+
+		using TPool = std::conditional_t<B_CONST, const CObjectPool, CObjectPool>;
+
+		// STL conformity
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<B_CONST, const T*, T*>;
+		using reference = std::conditional_t<B_CONST, const T&, T&>;
+
+		CBasicIterator()
+			: currentPos(0),
+			  pObject(nullptr),
+			  pPool(nullptr)
+		{}
+
+		CBasicIterator(TPool* p_pool, const bool b_begin)
+			: currentPos(0),
+			  pObject(nullptr),
+			  pPool(p_pool)
+		{
+			// Skip to the first in-use object or set to end sentinel
+			if (b_begin)
+				SkipUnused();
+			else
+				SkipToEnd();
+		}
+
+		// Conversion from a mutable to a const iterator
+		template <bool B_OTHER_CONST>
+			requires (B_CONST && !B_OTHER_CONST)
+		CBasicIterator(const CBasicIterator<B_OTHER_CONST>& other)
+			: currentPos(other.currentPos),
+			  pObject(other.pObject),
+			  pPool(other.pPool)
+		{}
+
+		// Dereference operator
+		reference operator*() const
+		{
+			return *pObject;
+		}
+
+		// Pointer access operator
+		pointer operator->() const
+		{
+			return pObject;
+		}
+
+		// Pre-increment
+		CBasicIterator& operator++()
+		{
+			++currentPos;
+			SkipUnused();
+			return *this;
+		}
+
+		// Post-increment
+		CBasicIterator operator++(int)
+		{
+			CBasicIterator temp = *this;
+			++(*this);
+			return temp;
+		}
+
+		// Pre-decrement
+		CBasicIterator& operator--()
+		{
+			SkipUnusedBackward();
+			return *this;
+		}
+
+		// Post-decrement
+		CBasicIterator operator--(int)
+		{
+			CBasicIterator temp = *this;
+			--(*this);
+			return temp;
+		}
+
+		// Equality comparison
+		bool operator==(const CBasicIterator& other) const
+		{
+			return pObject == other.pObject;
+		}
+
+		// Inequality comparison
+		bool operator!=(const CBasicIterator& other) const
+		{
+			return pObject != other.pObject;
+		}
+
+	private:
+		template <bool>
+		friend class CBasicIterator;
+
+		size_t currentPos;
+		pointer pObject;
+		TPool* pPool;
+
+		// Skip unused objects
+		void SkipUnused()
+		{
+			currentPos = pPool->FindUsed(currentPos);
+			pObject = pPool->IsInUse(currentPos) ? pPool->ObjectAt(currentPos) : nullptr;
+		}
+
+		// Move to the previous used object, decrementing `begin()` is undefined like for all iterators
+		void SkipUnusedBackward()
+		{
+			currentPos = pPool->FindUsedBackward(currentPos);
+			pObject = pPool->IsInUse(currentPos) ? pPool->ObjectAt(currentPos) : nullptr;
+		}
+
+		// End iterator points one past the last element (sentinel)
+		void SkipToEnd()
+		{
+			currentPos = pPool->Size();
+			pObject = nullptr;
+		}
+	};
+
+	using CIterator = CBasicIterator<false>;
+	using CConstIterator = CBasicIterator<true>;
+
+	/**
+	 * @brief One slot of the pool paired with its occupancy, the element type of `Slots()`.
+	 *
+	 * @tparam B_CONST `true` if the object must not be modified.
+	 */
+	template <bool B_CONST>
+	struct CBasicSlot
+	{
+		size_t idx = 0;
+		bool bInUse = false;
+		std::conditional_t<B_CONST, const T*, T*> pObject = nullptr;
+	};
+
+	using CSlot = CBasicSlot<false>;
+	using CConstSlot = CBasicSlot<true>;
+
+	/**
+	 * @class CObjectPool::CBasicSlotIterator
+	 * @brief Random-access iterator over *all* slots, yielding `CBasicSlot` values.
+	 *
+	 * Unlike `CIterator` it does not skip unused slots, so the distance between two
+	 * iterators is known and the range can be split. This makes `std::ranges`
+	 * algorithms and views which need random access (`drop`, `take`, binary searches)
+	 * and index arithmetic possible without first collecting pointers into a vector.
+	 *
+	 * ### Example
+	 * ```cpp
+	 * // the slots of one emitter, skipped to in O(1)
+	 * auto slots = particles.Slots() | std::views::drop(first) | std::views::take(count);
+	 * std::ranges::for_each(slots, [](auto slot) {
+	 *     if (slot.bInUse)
+	 *         slot.pObject->Update();
+	 * });
+	 * ```
+	 *
+	 * Dereferencing returns the slot by value (a proxy), so it is a C++20 random-access
+	 * iterator (`iterator_concept`), but only an input iterator for the legacy algorithms
+	 * (`iterator_category`). It can't be used with algorithms that need to swap elements
+	 * (e.g. `std::sort`) nor with the parallel standard algorithms, use `ForEachActive` there.
+	 *
+	 * @tparam B_CONST `true` for read-only access over a `const CObjectPool`.
+	 */
+	template <bool B_CONST>
+	class CBasicSlotIterator
+	{
+	public:
+		using TPool = std::conditional_t<B_CONST, const CObjectPool, CObjectPool>;
+
+		// STL conformity, the proxy reference only allows input iterators in the legacy sense
+		using iterator_concept = std::random_access_iterator_tag;
+		using iterator_category = std::input_iterator_tag;
+		using value_type = CBasicSlot<B_CONST>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = CBasicSlot<B_CONST>;
+
+		CBasicSlotIterator()
+			: currentPos(0),
+			  pPool(nullptr)
+		{}
+
+		CBasicSlotIterator(TPool* p_pool, const size_t pos)
+			: currentPos(pos),
+			  pPool(p_pool)
+		{}
+
+		reference operator*() const
+		{
+			return {currentPos, pPool->inUse[currentPos] == Detail::FLAG_USED, pPool->ObjectAt(currentPos)};
+		}
+
+		reference operator[](const difference_type offset) const
+		{
+			return *(*this + offset);
+		}
+
+		CBasicSlotIterator& operator++() { ++currentPos; return *this; }
+		CBasicSlotIterator operator++(int) { CBasicSlotIterator temp = *this; ++currentPos; return temp; }
+		CBasicSlotIterator& operator--() { --currentPos; return *this; }
+		CBasicSlotIterator operator--(int) { CBasicSlotIterator temp = *this; --currentPos; return temp; }
+		CBasicSlotIterator& operator+=(const difference_type offset) { currentPos += offset; return *this; }
+		CBasicSlotIterator& operator-=(const difference_type offset) { currentPos -= offset; return *this; }
+
+		friend CBasicSlotIterator operator+(CBasicSlotIterator it, const difference_type offset) { return it += offset; }
+		friend CBasicSlotIterator operator+(const difference_type offset, CBasicSlotIterator it) { return it += offset; }
+		friend CBasicSlotIterator operator-(CBasicSlotIterator it, const difference_type offset) { return it -= offset; }
+
+		friend difference_type operator-(const CBasicSlotIterator& lhs, const CBasicSlotIterator& rhs)
+		{
+			return static_cast<difference_type>(lhs.currentPos) - static_cast<difference_type>(rhs.currentPos);
+		}
+
+		bool operator==(const CBasicSlotIterator& other) const
+		{
+			return currentPos == other.currentPos;
+		}
+
+		auto operator<=>(const CBasicSlotIterator& other) const
+		{
+			return currentPos <=> other.currentPos;
+		}
+
+	private:
+		size_t currentPos;
+		TPool* pPool;
+	};
+
+	using CSlotIterator = CBasicSlotIterator<false>;
+	using CConstSlotIterator = CBasicSlotIterator<true>;
+
+	/** @brief Random-access range over all slots, returned by `Slots()`. */
+	template <bool B_CONST>
+	class CBasicSlotView
+	{
+	public:
+		using TPool = std::conditional_t<B_CONST, const CObjectPool, CObjectPool>;
+
+		explicit CBasicSlotView(TPool* p_pool)
+			: pPool(p_pool)
+		{}
+
+		CBasicSlotIterator<B_CONST> begin() const
+		{
+			return CBasicSlotIterator<B_CONST>(pPool, 0);
+		}
+
+		CBasicSlotIterator<B_CONST> end() const
+		{
+			return CBasicSlotIterator<B_CONST>(pPool, pPool->Size());
+		}
+
+		size_t size() const
+		{
+			return pPool->Size();
+		}
+
+		CBasicSlot<B_CONST> operator[](const size_t pos) const
+		{
+			return begin()[static_cast<std::ptrdiff_t>(pos)];
+		}
+
+	private:
+		TPool* pPool;
+	};
+
+	using CSlotView = CBasicSlotView<false>;
+	using CConstSlotView = CBasicSlotView<true>;
+
+	/**
+	 * @class CObjectPool::CRunIterator
+	 * @brief Forward iterator yielding runs of consecutive *used* elements as `std::span<T>`.
+	 *
+	 * Instead of checking the usage flag for every element, each step finds the next
+	 * maximal run of used slots. The inner loop over a span is a plain array loop
+	 * which the compiler can vectorize, so mostly-full pools iterate at close to raw array speed.
+	 *
+	 * ### Example
+	 * ```cpp
+	 * for (std::span<CParticle> run : particles.Runs())
+	 *     for (CParticle& particle : run)
+	 *         particle.position += particle.velocity * dt;
+	 * ```
+	 *
+	 * ### Design notes
+	 * - Runs are maximal: two yielded spans are always separated by at least one unused slot.
+	 * - Runs never wrap around the end of the pool.
+	 * - The pool must not be modified while iterating.
+	 */
+	class CRunIterator
+	{
+	public:
+		static constexpr bool B_BEGIN = true;
+		static constexpr bool B_END = false;
+
+		// STL conformity, spans are yielded by value which only allows input iterators in the legacy sense
+		using iterator_concept = std::forward_iterator_tag;
+		using iterator_category = std::input_iterator_tag;
+		using value_type = std::span<T>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const std::span<T>*;
+		using reference = std::span<T>;
+
+		CRunIterator()
+			: runStart(0),
+			  pPool(nullptr)
+		{}
+
+		CRunIterator(CObjectPool* p_pool, const bool b_begin)
+			: runStart(p_pool->Size()),
+			  pPool(p_pool)
+		{
+			if (b_begin)
+				FindRun(0);
+		}
+
+		reference operator*() const
+		{
+			return run;
+		}
+
+		pointer operator->() const
+		{
+			return &run;
+		}
+
+		CRunIterator& operator++()
+		{
+			FindRun(runStart + run.size());
+			return *this;
+		}
+
+		CRunIterator operator++(int)
+		{
+			CRunIterator temp = *this;
+			++(*this);
+			return temp;
+		}
+
+		bool operator==(const CRunIterator& other) const
+		{
+			return runStart == other.runStart;
+		}
+
+	private:
+		size_t runStart;
+		std::span<T> run;
+		CObjectPool* pPool;
+
+		// Find the first run starting at or after `pos` or become the end iterator
+		void FindRun(size_t pos)
+		{
+			const size_t end = pPool->Size();
+			runStart = pPool->FindUsed(pos);
+			pos = Detail::FindFlag(pPool->inUse.data(), runStart, end, Detail::FLAG_FREE);
+			run = runStart < end ? std::span<T>(pPool->ObjectAt(runStart), pos - runStart) : std::span<T>();
+		}
+	};
+
+	/** @brief Range adaptor over `CRunIterator`, returned by `Runs()`. */
+	class CRunView
+	{
+	public:
+		explicit CRunView(CObjectPool* p_pool)
+			: pPool(p_pool)
+		{}
+
+		CRunIterator begin() const
+		{
+			return CRunIterator(pPool, CRunIterator::B_BEGIN);
+		}
+
+		CRunIterator end() const
+		{
+			return CRunIterator(pPool, CRunIterator::B_END);
+		}
+
+	private:
+		CObjectPool* pPool;
+	};
+
+	/**
+	 * @class CSnapshot
+	 * @brief Copy of the objects and the occupancy of a pool, filled by `Snapshot`, applied by `Restore`.
+	 *
+	 * Keep one snapshot per saved state and pass it to `Snapshot` again: once it was sized for
+	 * the pool, taking a new snapshot into it doesn't allocate. The snapshot remembers the pool
+	 * and its change stamp, so `SnapshotDelta`/`RestoreDelta` know which blocks changed since.
+	 * The stats and observer policies are not part of the snapshot.
+	 */
+	class CSnapshot
+	{
+	public:
+		/** @brief Returns the capacity of the pool the snapshot was taken from, 0 if it is empty. */
+		[[nodiscard]]
+		size_t Size() const noexcept
+		{
+			return inUse.size();
+		}
+
+		/** @brief Returns the number of objects which were in use when the snapshot was taken. */
+		[[nodiscard]]
+		size_t ObjectsInUse() const noexcept
+		{
+			return objectsInUse;
+		}
+
+	private:
+		friend class CObjectPool;
+
+		std::vector<std::byte> objects;
+		std::vector<uint8_t> inUse;
+		Detail::CBlockSummary usedBlocks;
+		Detail::CBlockSummary freeBlocks;
+		std::vector<size_t> freePrev;
+		std::vector<size_t> freeNext;
+		size_t freeHead = NO_SLOT;
+		size_t nextIdx = 0;
+		size_t objectsInUse = 0;
+		uint64_t poolId = 0;
+		uint64_t stamp = 0;
+	};
+
+	using TResult = std::expected<T*, EPoolError>;
+	using TResultConst = std::expected<const T*, EPoolError>;
+	using TResultVoid = std::expected<void, EPoolError>;
+	using TResultSpan = std::expected<std::span<T>, EPoolError>;
+
+	/** @brief Moving or swapping the pool can only throw if doing so with one of the policies can. */
+	static constexpr bool NOTHROW_POLICY_MOVE
+		= std::is_nothrow_move_constructible_v<TStats> && std::is_nothrow_swappable_v<TStats>
+		&& std::is_nothrow_move_constructible_v<TObserver> && std::is_nothrow_swappable_v<TObserver>;
+
+	CObjectPool() = delete;
+	/**
+	 * @brief Constructs the pool and pre-allocates `size` objects.
+	 *
+	 * @param size Maximum number of objects managed by the pool.
+	 *
+	 * With this constructor each element is default-constructed.
+	 * No further allocations occur during usage.
+	 */
+	explicit CObjectPool(size_t size);
+	/**
+	 * @brief Constructs the pool and pre-allocates `size` objects.
+	 *
+	 * @param size Maximum number of objects managed by the pool.
+	 * @param args  Optional arguments forwarded to `T` constructor for all elements.
+	 *
+	 * With this constructor each element is constructed using the provided arguments.
+	 * No further allocations occur during usage.
+	 */
+	template <typename... Args>
+	explicit CObjectPool(size_t size, Args&&... args);
+	/**
+	 * @brief Constructs the pool inside caller-provided memory, e.g. an arena, shared memory or a stack buffer.
+	 *
+	 * @param buffer Memory for the objects. Slots start at the first address aligned for `T`,
+	 *               the pool gets as many slots as fit into the rest (see `BufferSize`).
+	 * @param args  Optional arguments forwarded to `T` constructor for all elements.
+	 *
+	 * The pool doesn't allocate its objects and doesn't own `buffer`, which must outlive
+	 * the pool; the destructor destroys the objects but leaves the memory to the caller.
+	 * Only the usage flags and the allocation policy structure are allocated
+	 * (about one byte per slot).
+	 */
+	template <typename... Args>
+	explicit CObjectPool(std::span<std::byte> buffer, Args&&... args);
+	~CObjectPool();
+
+	/** @brief Returns the number of bytes a buffer aligned to `alignof(T)` needs for `size` slots. */
+	[[nodiscard]]
+	static constexpr size_t BufferSize(size_t size) noexcept;
+
+	// Prevent assignment and pass-by-value (but may be implemented later)
+	CObjectPool(const CObjectPool&) = delete;
+	CObjectPool& operator=(const CObjectPool&) = delete;
+	/**
+	 * @brief Takes over the storage of `other` in O(1), leaving it as an empty pool of size 0.
+	 *
+	 * The objects aren't moved, so pointers to them stay valid and now refer into this pool.
+	 * Iterators of `other` are invalidated.
+	 */
+	CObjectPool(CObjectPool&& other) noexcept(NOTHROW_POLICY_MOVE);
+	/** @brief Releases the own objects and takes over the storage of `other` in O(1). */
+	CObjectPool& operator=(CObjectPool&& other) noexcept(NOTHROW_POLICY_MOVE);
+	/** @brief Exchanges the storage of both pools in O(1), e.g. for double-buffering. */
+	void swap(CObjectPool& other) noexcept(NOTHROW_POLICY_MOVE);
+	friend void swap(CObjectPool& lhs, CObjectPool& rhs) noexcept(NOTHROW_POLICY_MOVE)
+	{
+		lhs.swap(rhs);
+	}
+
+	/**
+	 * @brief Provides direct, unchecked access to the element at `pos`.
+	 *
+	 * @param pos Slot index (no bounds checking).
+	 * @return Raw pointer to the element.
+	 *
+	 * Use `Get()` when safety is required; use `operator[]` for high-performance access
+	 * when index validity is guaranteed. Like `Get()`, records the block as changed for
+	 * `SnapshotDelta`.
+	 */
+	T* operator[](size_t pos) noexcept;
+	/** @brief Provides direct, unchecked read-only access to the element at `pos`. */
+	const T* operator[](size_t pos) const noexcept;
+
+	/**
+	 * @brief Marks a specific slot as *in use* and returns a pointer to the object.
+	 *
+	 * @param pos Index of the slot to activate.
+	 * @return `T*` wrapped in `std::expected` if successful,
+	 *              or an error (`OUT_OF_RANGE`, `ALREADY_IN_USE`) otherwise.
+	 *
+	 * Activating a slot sets its usage flag to true.
+	 * Does not reconstruct the object.
+	 */
+	[[nodiscard]]
+	TResult Use(size_t pos) noexcept;
+	/**
+	 * @brief Finds the next free slot and marks it as *in use*.
+	 *
+	 * @param[out] found_pos Receives the index of the activated slot,
+	 *                       or is not changed if the pool is full.
+	 * @return Pointer to the activated object, or `std::unexpected(EPoolError::FULL)`
+	 *         if no free slots remain.
+	 *
+	 * This function performs a linear search from the last inserted objects position
+	 * to find the first available position, ensuring fast fill order.
+	 */
+	[[nodiscard]]
+	TResult UseNext(size_t& found_pos) noexcept;
+	/**
+	 * @brief Finds the next free slot, reconstructs its object, and activates it.
+	 *
+	 * @param[out] found_pos Receives the index of the activated slot,
+	 *                       or is not changed if the pool is full.
+	 * @return Pointer to the activated object, or error (`FULL`) if pool has no free slots.
+	 *
+	 * Equivalent to calling `Replace(index)` followed by `Use(index)`.
+	 */
+	[[nodiscard]]
+	TResult UseNextReplace(size_t& found_pos) noexcept;
+	/**
+	 * @brief Finds the next free slot, reconstructs its object with new arguments, and activates it.
+	 *
+	 * @param[out] found_pos Receives the index of the activated slot,
+	 *                       or is not changed if the pool is full.
+	 * @param args Arguments forwarded to `T`'s constructor for in-place reconstruction.
+	 * @return Pointer to the activated object, or error (`FULL`) if pool has no free slots.
+	 *
+	 * Equivalent to calling `Replace(index, args...)` followed by `Use(index)`.
+	 */
+	template <typename... Args>
+	[[nodiscard]]
+	TResult UseNextReplace(size_t& found_pos, Args&&... args) noexcept;
+	/**
+	 * @brief Finds the free slot closest to `hint` and marks it as *in use*.
+	 *
+	 * @param hint Index the new object should be placed close to, e.g. a related object.
+	 * @param[out] found_pos Receives the index of the activated slot,
+	 *                       or is not changed on error.
+	 * @return Pointer to the activated object, or error (`OUT_OF_RANGE`, `FULL`) otherwise.
+	 *
+	 * Searches forwards and backwards from `hint` and picks the nearer hit, preferring the
+	 * forward one on a tie. Objects acquired with the same hint end up next to each other,
+	 * so they share cache lines when they are updated together.
+	 * Ignores `ALLOC_POLICY` and does not reconstruct the object.
+	 */
+	[[nodiscard]]
+	TResult UseNear(size_t hint, size_t& found_pos) noexcept;
+	/**
+	 * @brief Finds `count` consecutive free slots and marks them as *in use*.
+	 *
+	 * @param count Number of adjacent slots to activate.
+	 * @param[out] found_pos Receives the index of the first activated slot,
+	 *                       or is not changed on error.
+	 * @return The activated objects as one contiguous span, or error (`OUT_OF_RANGE` if
+	 *         `count` is zero or exceeds the capacity, `FULL` if no free run is long enough).
+	 *
+	 * Takes the lowest free run which fits, independent of `ALLOC_POLICY`. The search hops
+	 * from run to run via the block summaries, so it is proportional to the number of
+	 * free runs skipped, not to `count` times the pool size.
+	 * Does not reconstruct the objects; release them with `UnUseRange` or one by one.
+	 */
+	[[nodiscard]]
+	TResultSpan UseRange(size_t count, size_t& found_pos) noexcept;
+	/**
+	 * @brief Returns a pointer to the object at `index` if it is currently in use.
+	 *
+	 * @param pos Index of the slot to query.
+	 * @return Pointer wrapped in `std::expected`, or error (`OUT_OF_RANGE`, `NOT_IN_USE`).
+	 *
+	 * Safe alternative to `operator[]`, which doesn't check bounds nor usage.
+	 * Reported to the observer via `OnGet` if it is an `access_observer`.
+	 */
+	[[nodiscard]]
+	TResult Get(size_t pos) noexcept;
+	/**
+	 * @brief Returns a pointer to the object at `index` if it is currently in use.
+	 *
+	 * @param pos Index of the slot to query.
+	 * @return Pointer wrapped in `std::expected`, or error (`OUT_OF_RANGE`, `NOT_IN_USE`).
+	 *
+	 * Safe alternative to `operator[]`, which doesn't check bounds nor usage.
+	 */
+	[[nodiscard]]
+	TResultConst Get(size_t pos) const noexcept;
+	/**
+	 * @brief Checks whether the object at `pos` is active.
+	 *
+	 * @param pos Index of the slot to check.
+	 * @return `true` if slot is in use and within range, otherwise `false`.
+	 */
+	[[nodiscard]]
+	bool IsInUse(size_t pos) const noexcept;
+	/**
+	 * @brief Marks the given slot as *unused* and reconstructs the object.
+	 *
+	 * @param pos Index to deactivate.
+	 * @return Empty `expected` on success, or error (`OUT_OF_RANGE`, `ALREADY_UNUSED`) otherwise.
+	 *
+	 * Once marked unused, the slot becomes available for subsequent `Use` or `UseNext` calls.
+	 */
+	TResultVoid UnUse(size_t pos) noexcept;
+	/**
+	 * @brief Marks the given slot as *unused* and reconstructs the object.
+	 *
+	 * @param pos Index to deactivate.
+	 * @param args  Optional arguments for reinitializing the element via placement new.
+	 * @return Empty `expected` on success, or error (`OUT_OF_RANGE`, `ALREADY_UNUSED`) otherwise.
+	 *
+	 * Once marked unused, the slot becomes available for subsequent `Use` or `UseNext` calls.
+	 */
+	template <typename... Args>
+	TResultVoid UnUse(size_t pos, Args&&... args) noexcept;
+	/**
+	 * @brief Marks the `count` slots starting at `pos` as *unused* and reconstructs their objects.
+	 *
+	 * @param pos Index of the first slot to deactivate.
+	 * @param count Number of slots to deactivate.
+	 * @return Empty `expected` on success, or error (`OUT_OF_RANGE`, `ALREADY_UNUSED`) otherwise.
+	 *
+	 * The range is validated first, on error no slot is released.
+	 */
+	TResultVoid UnUseRange(size_t pos, size_t count) noexcept;
+	/**
+	 * @brief Reconstructs the object at the given index (regardless of usage state).
+	 *
+	 * @param pos Index of the element to reconstruct.
+	 * @return Empty `expected` on success, or `OUT_OF_RANGE` on invalid index.
+	 *
+	 * This operation marks the element as unused.
+	 * It is primarily intended to reset or repopulate the object.
+	 */
+	[[nodiscard]]
+	TResultVoid Replace(size_t pos) noexcept;
+	/**
+	 * @brief Reconstructs the object at the given index (regardless of usage state).
+	 *
+	 * @param pos Index of the element to reconstruct.
+	 * @param args  Optional arguments for `T`'s constructor.
+	 * @return Empty `expected` on success, or `OUT_OF_RANGE` on invalid index.
+	 *
+	 * This operation marks the element as unused.
+	 * It is primarily intended to reset or repopulate the object.
+	 */
+	template <typename... Args>
+	[[nodiscard]]
+	TResultVoid Replace(size_t pos, Args&&... args) noexcept;
+
+	/**
+	 * @brief Returns begin iterator spanning all *active* elements in the pool.
+	 *
+	 * Iteration skips unused slots and supports STL algorithms and C++23 ranges.
+	 * Example:
+	 * ```cpp
+	 * for (auto& obj : myPool)
+	 *     obj.Update();
+	 * ```
+	 */
+	CIterator begin();
+	/** @brief Returns end iterator pointing one past the last element. */
+	CIterator end();
+	/** @brief Returns read-only begin iterator spanning all *active* elements in the pool. */
+	CConstIterator begin() const;
+	/** @brief Returns read-only end iterator pointing one past the last element. */
+	CConstIterator end() const;
+	/** @brief Returns read-only begin iterator, also for non-const pools. */
+	CConstIterator cbegin() const;
+	/** @brief Returns read-only end iterator, also for non-const pools. */
+	CConstIterator cend() const;
+
+	/**
+	 * @brief Calls `func` for every *active* element, splitting the pool across threads.
+	 *
+	 * @param policy Standard execution policy, e.g. `std::execution::par`.
+	 * @param func Callable invoked as `func(T&)`. Must be safe to call concurrently
+	 *             for different elements when a parallel policy is used.
+	 *
+	 * The slot range is split into chunks of at least `MIN_PARALLEL_CHUNK` slots
+	 * whose byte size is a multiple of a cache line. Chunk boundaries are placed on
+	 * the slots which start a cache line, so two threads never write to the same line.
+	 * The owned storage always starts on a line; for a caller-provided buffer this
+	 * only holds if some slot starts on a line, e.g. if the buffer is 64-byte aligned.
+	 * Each chunk is processed sequentially and only its active elements are visited.
+	 * The pool itself must not be modified during the call, reading it through `Get`,
+	 * `IsInUse` or `operator[]` from `func` is fine.
+	 *
+	 * ```cpp
+	 * particles.ForEachActive(std::execution::par, [dt](CParticle& particle) {
+	 *     particle.Update(dt);
+	 * });
+	 * ```
+	 */
+	template <typename TExecutionPolicy, typename TFunc>
+		requires std::is_execution_policy_v<std::remove_cvref_t<TExecutionPolicy>>
+	void ForEachActive(TExecutionPolicy&& policy, TFunc&& func);
+	/** @brief Sequential `ForEachActive` which calls `func(T&)` for every *active* element. */
+	template <typename TFunc>
+	void ForEachActive(TFunc&& func);
+
+	/**
+	 * @brief Returns a range over all runs of consecutive *active* elements.
+	 *
+	 * Each element of the range is a `std::span<T>` over one run, see `CRunIterator`.
+	 */
+	CRunView Runs();
+
+	/**
+	 * @brief Returns a random-access range over *all* slots paired with their occupancy.
+	 *
+	 * Use it for index based access with the C++20 range algorithms, see `CBasicSlotIterator`.
+	 * The parallel standard algorithms need legacy forward iterators, which the proxy slots
+	 * can't provide; use `ForEachActive(policy, func)` to process the pool in parallel.
+	 */
+	CSlotView Slots();
+	/** @brief Returns a read-only random-access range over *all* slots paired with their occupancy. */
+	CConstSlotView Slots() const;
+
+	/**
+	 * @brief Moves all *active* objects into the lowest slots, so they form a dense prefix.
+	 *
+	 * Repeatedly moves the active object with the highest index into the lowest free slot
+	 * (via move construction) until no free slot is left below an active one. The vacated
+	 * slot is reconstructed with `T()`, like a slot released by `UnUse`.
+	 * Every move is reported to `on_relocate(old_pos, new_pos)`, so owners can fix their
+	 * indices, and to the observer if it is a `relocation_observer`.
+	 *
+	 * ```cpp
+	 * particles.Compact([&](size_t old_pos, size_t new_pos) {
+	 *     handles[owners[old_pos]] = new_pos;
+	 * });
+	 * ```
+	 *
+	 * Pointers and iterators to moved objects are invalidated.
+	 *
+	 * @param on_relocate Callable invoked as `on_relocate(size_t old_pos, size_t new_pos)`.
+	 * @return Number of objects moved.
+	 */
+	template <typename TFunc>
+		requires std::move_constructible<T> && std::invocable<TFunc&, size_t, size_t>
+	size_t Compact(TFunc&& on_relocate);
+	/**
+	 * @brief Moves all *active* objects into the lowest slots and returns the remap table.
+	 *
+	 * @return Table of size `Size()` where `remap[old_pos]` is the new index of the object
+	 *         previously at `old_pos`. Unmoved objects and free slots map to themselves.
+	 */
+	[[nodiscard]]
+	std::vector<size_t> Compact() requires std::move_constructible<T>;
+
+	/**
+	 * @brief Copies all objects and the occupancy into `snapshot`.
+	 *
+	 * The storage is copied with one `memcpy`. Allocates only if `snapshot` wasn't taken from
+	 * a pool of the same capacity before, so a reused snapshot is filled without allocation.
+	 */
+	void Snapshot(CSnapshot& snapshot) const requires std::is_trivially_copyable_v<T>;
+	/** @brief Returns a new snapshot of all objects and the occupancy. */
+	[[nodiscard]]
+	CSnapshot Snapshot() const requires std::is_trivially_copyable_v<T>;
+	/**
+	 * @brief Updates an earlier snapshot of this pool, copying only the blocks written since.
+	 *
+	 * Every mutable access stamps the block (`BLOCK_SIZE` slots) of the slot: `Use*`, `UnUse*`,
+	 * `Replace`, `Compact`, a mutable `Get` or `operator[]`. Mutable iteration (`begin()`,
+	 * `Runs()`, `ForEachActive`) stamps all blocks with used slots, a mutable `Slots()` view
+	 * all blocks. Only blocks stamped after `snapshot` was taken are copied, objects and
+	 * occupancy alike, so the cost follows the number of changed blocks, not the capacity.
+	 * Writes through a pointer obtained before the snapshot are not seen; fetch it again with
+	 * `Get` after taking a snapshot. Falls back to a full snapshot if `snapshot` was taken
+	 * from another pool. A stamp is one relaxed atomic store of the current epoch, so mutable
+	 * `Get`/`operator[]` calls for different slots may run concurrently; pools of types which
+	 * aren't trivially copyable can't be snapshotted and don't stamp at all.
+	 *
+	 * @return Number of slots copied.
+	 */
+	size_t SnapshotDelta(CSnapshot& snapshot) const requires std::is_trivially_copyable_v<T>;
+	/**
+	 * @brief Resets all objects and the occupancy to the state saved in `snapshot`.
+	 *
+	 * @return Empty `expected` on success, or `OUT_OF_RANGE` if `snapshot` was taken from a pool
+	 *         with a different capacity; the pool is left unchanged then.
+	 *
+	 * The policies see the rollback like any other change: a slot which becomes used or free
+	 * is reported with `OnAcquire`/`OnUse` or `OnRelease`/`OnUnUse`, a used or free slot whose
+	 * object differs with `OnReplace`. Pointers into the pool stay valid, the objects they refer
+	 * to are overwritten.
+	 */
+	TResultVoid Restore(const CSnapshot& snapshot) requires std::is_trivially_copyable_v<T>;
+	/**
+	 * @brief Like `Restore`, but only writes the blocks which were stamped since `snapshot` was taken.
+	 *
+	 * See `SnapshotDelta` for the tracked accesses. Falls back to a full restore if `snapshot`
+	 * was taken from another pool.
+	 *
+	 * @return Number of slots copied, or `OUT_OF_RANGE` if the capacities differ.
+	 */
+	std::expected<size_t, EPoolError> RestoreDelta(const CSnapshot& snapshot) requires std::is_trivially_copyable_v<T>;
+
+	/** @brief Returns the total number of slots in the pool. */
+	[[nodiscard]]
+	size_t Size() const noexcept;
+	/** @brief Returns the number of currently active (used) objects. */
+	[[nodiscard]]
+	size_t ObjectsInUse() const noexcept;
+	/** @brief Returns the statistics recorded by the `TStats` policy. */
+	[[nodiscard]]
+	const TStats& Stats() const noexcept;
+	/** @brief Returns the statistics recorded by the `TStats` policy, e.g. to reset them. */
+	[[nodiscard]]
+	TStats& Stats() noexcept;
+	/** @brief Returns the `TObserver` instance receiving slot events. */
+	[[nodiscard]]
+	const TObserver& Observer() const noexcept;
+	/** @brief Returns the `TObserver` instance receiving slot events, e.g. to attach a sink. */
+	[[nodiscard]]
+	TObserver& Observer() noexcept;
+
+protected:
 	/**
-	 * @brief Reconstructs the object at the given index (regardless of usage state).
+	 * @brief Abstract byte object for storing T in the object pool.
 	 *
-	 * @param pos Index of the element to reconstruct.
-	 * @param args  Optional arguments for `T`'s constructor.
-	 * @return Empty `expected` on success, or `OUT_OF_RANGE` on invalid index.
+	 * The usage flags are kept in a separate array (`inUse`), so `sizeof(CObject) == sizeof(T)`
+	 * and consecutive slots form a contiguous array of `T`.
+	 */
+	struct CObject
+	{
+		alignas(T) std::byte object[sizeof(T)];
+	};
+	static_assert(sizeof(CObject) == sizeof(T));
+
+	/** @brief Minimum number of slots processed by one task of the parallel `ForEachActive`. */
+	static constexpr size_t MIN_PARALLEL_CHUNK = 1024;
+	/** @brief Number of slots per parallel chunk, rounded up to whole cache lines. */
+	static constexpr size_t PARALLEL_CHUNK
+		= std::lcm(MIN_PARALLEL_CHUNK, Detail::CACHE_LINE_SIZE / std::gcd(sizeof(CObject), Detail::CACHE_LINE_SIZE));
+
+	/** @brief Marks the end of the free list of `MOST_RECENTLY_FREED`. */
+	static constexpr size_t NO_SLOT = static_cast<size_t>(-1);
+	/** @brief Whether `freeBlocks` is maintained, the LIFO free list doesn't need it. */
+	static constexpr bool B_FREE_SUMMARY = ALLOC_POLICY != EAllocPolicy::MOST_RECENTLY_FREED;
+	/** @brief Whether writes are stamped per block for `SnapshotDelta`, only pools which can be snapshotted pay for it. */
+	static constexpr bool B_TRACK_CHANGES = std::is_trivially_copyable_v<T>;
+
+	/**
+	 * @brief Returns the first slot at or after `from` whose flag is `value`, or `poolSize`.
 	 *
-	 * This operation marks the element as unused.
-	 * It is primarily intended to reset or repopulate the object.
+	 * Scans the next `BLOCK_SIZE` flags and then jumps via `summary` (the blocks containing
+	 * such a slot) to the next candidate block, so the search is O(log64 n) even in a sparse pool.
 	 */
-	template <typename... Args>
 	[[nodiscard]]
-	TResultVoid Replace(size_t pos, Args&&... args) noexcept;
+	size_t FindSummarized(const Detail::CBlockSummary& summary, uint8_t value, size_t from) const noexcept;
+	/** @brief `FindSummarized` which adds the number of inspected flags to `scanned`. */
+	[[nodiscard]]
+	size_t FindSummarized(const Detail::CBlockSummary& summary, uint8_t value, size_t from, size_t& scanned) const noexcept;
+	/** @brief Returns the last slot before `to` whose flag is `value`, or `to` if there is none. */
+	[[nodiscard]]
+	size_t FindSummarizedBackward(const Detail::CBlockSummary& summary, uint8_t value, size_t to) const noexcept;
+	/** @brief Returns the first used slot at or after `from`, or `poolSize`. */
+	[[nodiscard]]
+	size_t FindUsed(size_t from) const noexcept;
+	/** @brief Returns the last used slot before `to`, or `to` if there is none. */
+	[[nodiscard]]
+	size_t FindUsedBackward(size_t to) const noexcept;
+	/** @brief Returns the first free slot at or after `start`, wrapping around, or `poolSize` if the pool is full. */
+	[[nodiscard]]
+	size_t FindFreeWrapped(size_t start) const noexcept;
+	/** @brief `FindFreeWrapped` which adds the number of inspected flags to `scanned`. */
+	[[nodiscard]]
+	size_t FindFreeWrapped(size_t start, size_t& scanned) const noexcept;
+	/** @brief Returns the free slot closest to `hint`, or `poolSize` if the pool is full. */
+	[[nodiscard]]
+	size_t FindFreeNear(size_t hint) const noexcept;
+	/** @brief Returns the first free slot at or after `from`, or `poolSize`. */
+	[[nodiscard]]
+	size_t FindFree(size_t from) const noexcept;
+	/** @brief Returns the start of the lowest run of at least `count` free slots, or `poolSize`. */
+	[[nodiscard]]
+	size_t FindFreeRun(size_t count) const noexcept;
+
+	/**
+	 * @brief Finds the free slot to hand out next according to `ALLOC_POLICY`.
+	 *
+	 * For `ROUND_ROBIN` this is the first free slot at or after `nextIdx` (wrapping around).
+	 * The number of usage flags inspected on the way is recorded by the stats policy for
+	 * every policy: blocks skipped via the summary don't count, and a pop from the free
+	 * list of `MOST_RECENTLY_FREED` inspects one slot (none if the list is empty).
+	 *
+	 * @return Index of the free slot, or `poolSize` if the pool is full.
+	 */
+	[[nodiscard]]
+	size_t FindNextFree() noexcept;
+	/** @brief updates class member `nextIdx` with the next unused index (`ROUND_ROBIN` only). */
+	void UpdateNextIdx() noexcept;
+	/** @brief Sets the flag of the free slot `pos` and updates the structure of the allocation policy. */
+	void MarkUsed(size_t pos) noexcept;
+	/** @brief Clears the flag of the used slot `pos` and updates the structure of the allocation policy. */
+	void MarkFree(size_t pos) noexcept;
+	/** @brief Builds the block summaries, the change stamps and the allocation policy structure for a pool without used slots. */
+	void InitAllocPolicy();
+	/** @brief Returns the object in slot `pos` without recording a change, for the iterators. */
+	[[nodiscard]]
+	T* ObjectAt(size_t pos) noexcept;
+	[[nodiscard]]
+	const T* ObjectAt(size_t pos) const noexcept;
+	/**
+	 * @brief Stamps the block of `pos` as changed for `SnapshotDelta`/`RestoreDelta`.
+	 *
+	 * Only reads the current epoch and stores it with a relaxed atomic store, so concurrent
+	 * mutable accesses, e.g. from the callbacks of a parallel `ForEachActive`, don't race.
+	 * A no-op unless `B_TRACK_CHANGES`.
+	 */
+	void MarkChanged(size_t pos) noexcept;
+	/** @brief Stamps every block with a used slot as changed, before handing out mutable access to all active objects. */
+	void MarkActiveChanged() noexcept;
+	/** @brief Stamps all blocks as changed at once. */
+	void MarkAllChanged() noexcept;
+	/** @brief Returns whether `block` was written in a later epoch than the snapshot taken in `stamp`. */
+	[[nodiscard]]
+	bool IsBlockChanged(size_t block, uint64_t stamp) const noexcept;
+	/** @brief Copies the objects and the occupancy of `block` into `snapshot`. */
+	void CopyBlock(CSnapshot& snapshot, size_t block) const noexcept;
+	/**
+	 * @brief Overwrites `block` with its state in `snapshot` and notifies the policies of every slot which differs.
+	 *
+	 * @return Number of slots copied.
+	 */
+	size_t RestoreBlock(const CSnapshot& snapshot, size_t block) noexcept;
+	/** @brief Copies the pool-wide allocation state (summaries, free list head, counters) into `snapshot`. */
+	void CopyAllocState(CSnapshot& snapshot) const;
+	/** @brief Replaces the pool-wide allocation state with the one of `snapshot`. */
+	void RestoreAllocState(const CSnapshot& snapshot);
+	/** @brief Constructs the observer with the pool capacity if it accepts one. */
+	static TObserver MakeObserver(size_t size);
+	/** @brief Returns the slots which fit into `buffer` behind its first address aligned for `T`. */
+	[[nodiscard]]
+	static std::span<CObject> SlotsIn(std::span<std::byte> buffer) noexcept;
+
+	size_t poolSize;
+	size_t nextIdx;
+	size_t objectsInUse;
+	/** Owned slot storage starting on a cache line, empty if the pool was built on a caller-provided buffer. */
+	std::vector<CObject, Detail::CCacheLineAllocator<CObject>> storage;
+	/** First slot, in `storage` or in the caller's buffer. */
+	CObject* pool;
+	std::vector<uint8_t> inUse;
+	/** Blocks with at least one used slot, to skip empty regions while iterating. */
+	Detail::CBlockSummary usedBlocks;
+	/** Blocks with at least one free slot, see `B_FREE_SUMMARY`. */
+	Detail::CBlockSummary freeBlocks;
+	/** `MOST_RECENTLY_FREED`: intrusive free list, most recently freed slot first. */
+	std::vector<size_t> freePrev;
+	std::vector<size_t> freeNext;
+	size_t freeHead = NO_SLOT;
+	/** Per block, the epoch of its last write, see `SnapshotDelta`. Empty unless `B_TRACK_CHANGES`. */
+	std::vector<uint64_t> blockStamps;
+	/** Current epoch, advanced by every snapshot, which remembers the epoch it was taken in. */
+	mutable std::atomic<uint64_t> changeStamp = 0;
+	/** Epoch of the last write which may have touched any block. */
+	uint64_t allChangedStamp = 0;
+	uint64_t poolId = Detail::NextPoolId();
+	[[no_unique_address]] TStats stats;
+	[[no_unique_address]] TObserver observer;
+};
+
+// implementation
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::CObjectPool(const size_t size)
+	: poolSize(size),
+	  nextIdx(0),
+	  objectsInUse(0),
+	  storage(size),
+	  pool(storage.data()),
+	  inUse(std::vector<uint8_t>(size)),
+	  observer(MakeObserver(size))
+{
+	for (size_t pos = 0; pos < poolSize; ++pos)
+	{
+		// construct value in memory of aligned storage
+		// using in place operator new
+		::new(&pool[pos].object) T();
+	}
+	InitAllocPolicy();
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+template <typename... Args>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::CObjectPool(const size_t size, Args&&... args)
+	: poolSize(size),
+	  nextIdx(0),
+	  objectsInUse(0),
+	  storage(size),
+	  pool(storage.data()),
+	  inUse(std::vector<uint8_t>(size)),
+	  observer(MakeObserver(size))
+{
+	for (size_t pos = 0; pos < poolSize; ++pos)
+	{
+		// construct value in memory of aligned storage
+		// using in place operator new
+		::new(&pool[pos].object) T(std::forward<Args>(args)...);
+	}
+	InitAllocPolicy();
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+template <typename... Args>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::CObjectPool(const std::span<std::byte> buffer, Args&&... args)
+	: poolSize(SlotsIn(buffer).size()),
+	  nextIdx(0),
+	  objectsInUse(0),
+	  pool(SlotsIn(buffer).data()),
+	  inUse(std::vector<uint8_t>(poolSize)),
+	  observer(MakeObserver(poolSize))
+{
+	for (size_t pos = 0; pos < poolSize; ++pos)
+		::new(&pool[pos].object) T(std::forward<Args>(args)...);
+	InitAllocPolicy();
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::~CObjectPool()
+{
+	for (size_t pos = 0; pos < poolSize; ++pos)
+		std::destroy_at(std::launder(reinterpret_cast<T*>(&pool[pos].object)));
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::CObjectPool(CObjectPool&& other) noexcept(NOTHROW_POLICY_MOVE)
+	: poolSize(std::exchange(other.poolSize, 0)),
+	  nextIdx(std::exchange(other.nextIdx, 0)),
+	  objectsInUse(std::exchange(other.objectsInUse, 0)),
+	  storage(std::move(other.storage)),
+	  pool(std::exchange(other.pool, nullptr)),
+	  inUse(std::move(other.inUse)),
+	  usedBlocks(std::exchange(other.usedBlocks, {})),
+	  freeBlocks(std::exchange(other.freeBlocks, {})),
+	  freePrev(std::move(other.freePrev)),
+	  freeNext(std::move(other.freeNext)),
+	  freeHead(std::exchange(other.freeHead, NO_SLOT)),
+	  blockStamps(std::move(other.blockStamps)),
+	  changeStamp(other.changeStamp.load(std::memory_order_relaxed)),
+	  allChangedStamp(other.allChangedStamp),
+	  poolId(std::exchange(other.poolId, Detail::NextPoolId())),
+	  stats(std::move(other.stats)),
+	  observer(std::move(other.observer))
+{
+	// a moved-from vector is empty in practice, but not guaranteed to be
+	other.storage.clear();
+	other.inUse.clear();
+	other.freePrev.clear();
+	other.freeNext.clear();
+	other.blockStamps.clear();
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>& CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::operator=(CObjectPool&& other) noexcept(NOTHROW_POLICY_MOVE)
+{
+	// the temporary destroys the objects previously owned by this pool
+	CObjectPool temp(std::move(other));
+	swap(temp);
+	return *this;
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+void CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::swap(CObjectPool& other) noexcept(NOTHROW_POLICY_MOVE)
+{
+	using std::swap;
+	swap(poolSize, other.poolSize);
+	swap(nextIdx, other.nextIdx);
+	swap(objectsInUse, other.objectsInUse);
+	swap(storage, other.storage);
+	swap(pool, other.pool);
+	swap(inUse, other.inUse);
+	swap(usedBlocks, other.usedBlocks);
+	swap(freeBlocks, other.freeBlocks);
+	swap(freePrev, other.freePrev);
+	swap(freeNext, other.freeNext);
+	swap(freeHead, other.freeHead);
+	swap(blockStamps, other.blockStamps);
+	changeStamp.store(other.changeStamp.exchange(changeStamp.load(std::memory_order_relaxed), std::memory_order_relaxed),
+	                  std::memory_order_relaxed);
+	swap(allChangedStamp, other.allChangedStamp);
+	swap(poolId, other.poolId);
+	swap(stats, other.stats);
+	swap(observer, other.observer);
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+T* CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::operator[](const size_t pos) noexcept
+{
+	MarkChanged(pos);
+	return std::launder(reinterpret_cast<T*>(&pool[pos].object));
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+const T* CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::operator[](const size_t pos) const noexcept
+{
+	return std::launder(reinterpret_cast<const T*>(&pool[pos].object));
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::TResult CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::Use(const size_t pos) noexcept
+{
+	if (pos >= poolSize)
+		return std::unexpected(EPoolError::OUT_OF_RANGE);
+
+	if (inUse[pos])
+		return std::unexpected(EPoolError::ALREADY_IN_USE);
+
+	MarkUsed(pos);
+	UpdateNextIdx();
+	objectsInUse++;
+	stats.OnAcquire(objectsInUse);
+	observer.OnUse(pos);
+	return std::launder(reinterpret_cast<T*>(&pool[pos].object));
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::TResult CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::UseNext(size_t& found_pos) noexcept
+{
+	const size_t pos = FindNextFree();
+	if (pos == poolSize)
+	{
+		stats.OnFull();
+		observer.OnFull();
+		return std::unexpected(EPoolError::FULL);
+	}
+
+	MarkUsed(pos);
+	found_pos = pos;
+	nextIdx = pos; // all slots between the old `nextIdx` and `pos` are used, don't scan them again
+	UpdateNextIdx();
+	objectsInUse++;
+	stats.OnAcquire(objectsInUse);
+	observer.OnUse(pos);
+	return std::launder(reinterpret_cast<T*>(&pool[pos].object));
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::TResult CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::UseNextReplace(size_t& found_pos) noexcept
+{
+	const size_t pos = FindNextFree();
+	if (pos == poolSize)
+	{
+		stats.OnFull();
+		observer.OnFull();
+		return std::unexpected(EPoolError::FULL);
+	}
+
+	if (auto result = Replace(pos); !result.has_value())
+		[[unlikely]] // Replace only returns error out of bounds
+		return std::unexpected(result.error());
+	MarkUsed(pos);
+	found_pos = pos;
+	objectsInUse++;
+	nextIdx = pos; // all slots between the old `nextIdx` and `pos` are used, don't scan them again
+	UpdateNextIdx();
+	stats.OnAcquire(objectsInUse);
+	observer.OnUse(pos);
+	return std::launder(reinterpret_cast<T*>(&pool[pos].object));
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+template <typename... Args>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::TResult CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::UseNextReplace(size_t& found_pos, Args&&... args) noexcept
+{
+	const size_t pos = FindNextFree();
+	if (pos == poolSize)
+	{
+		stats.OnFull();
+		observer.OnFull();
+		return std::unexpected(EPoolError::FULL);
+	}
+
+	if (auto result = Replace(pos, std::forward<Args>(args)...); !result.has_value())
+		[[unlikely]] // Replace only returns error out of bounds
+		return std::unexpected(result.error());
+	MarkUsed(pos);
+	found_pos = pos;
+	objectsInUse++;
+	nextIdx = pos; // all slots between the old `nextIdx` and `pos` are used, don't scan them again
+	UpdateNextIdx();
+	stats.OnAcquire(objectsInUse);
+	observer.OnUse(pos);
+	return std::launder(reinterpret_cast<T*>(&pool[pos].object));
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::TResult CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::UseNear(const size_t hint, size_t& found_pos) noexcept
+{
+	if (hint >= poolSize)
+		return std::unexpected(EPoolError::OUT_OF_RANGE);
+
+	const size_t pos = FindFreeNear(hint);
+	if (pos == poolSize)
+	{
+		stats.OnFull();
+		observer.OnFull();
+		return std::unexpected(EPoolError::FULL);
+	}
+
+	MarkUsed(pos);
+	found_pos = pos;
+	UpdateNextIdx();
+	objectsInUse++;
+	stats.OnAcquire(objectsInUse);
+	observer.OnUse(pos);
+	return std::launder(reinterpret_cast<T*>(&pool[pos].object));
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::TResultSpan CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::UseRange(const size_t count, size_t& found_pos) noexcept
+{
+	if (count == 0 || count > poolSize)
+		return std::unexpected(EPoolError::OUT_OF_RANGE);
+
+	const size_t start = FindFreeRun(count);
+	if (start == poolSize)
+	{
+		stats.OnFull();
+		observer.OnFull();
+		return std::unexpected(EPoolError::FULL);
+	}
+
+	for (size_t pos = start; pos < start + count; ++pos)
+	{
+		MarkUsed(pos);
+		objectsInUse++;
+		stats.OnAcquire(objectsInUse);
+		observer.OnUse(pos);
+	}
+	UpdateNextIdx();
+	found_pos = start;
+	return std::span<T>(std::launder(reinterpret_cast<T*>(&pool[start].object)), count);
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::TResult CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::Get(const size_t pos) noexcept
+{
+	if (pos >= poolSize)
+		return std::unexpected(EPoolError::OUT_OF_RANGE);
+	if (!inUse[pos])
+		return std::unexpected(EPoolError::NOT_IN_USE);
+	MarkChanged(pos);
+	if constexpr (access_observer<TObserver>)
+		observer.OnGet(pos);
+	return std::launder(reinterpret_cast<T*>(&pool[pos].object));
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::TResultConst CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::Get(const size_t pos) const noexcept
+{
+	if (pos >= poolSize)
+		return std::unexpected(EPoolError::OUT_OF_RANGE);
+	if (!inUse[pos])
+		return std::unexpected(EPoolError::NOT_IN_USE);
+	return std::launder(reinterpret_cast<const T*>(&pool[pos].object));
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+bool CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::IsInUse(const size_t pos) const noexcept
+{
+	if (pos >= poolSize)
+		return false;
+	return inUse[pos] == Detail::FLAG_USED;
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::TResultVoid CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::UnUse(const size_t pos) noexcept
+{
+	if (pos >= poolSize)
+		return std::unexpected(EPoolError::OUT_OF_RANGE);
+	if (!inUse[pos])
+		return std::unexpected(EPoolError::ALREADY_UNUSED);
+
+	(void)Replace(pos);
+	objectsInUse--;
+	stats.OnRelease();
+	observer.OnUnUse(pos);
+	return {};
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+template <typename... Args>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::TResultVoid CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::UnUse(const size_t pos, Args&&... args) noexcept
+{
+	if (pos >= poolSize)
+		return std::unexpected(EPoolError::OUT_OF_RANGE);
+	if (!inUse[pos])
+		return std::unexpected(EPoolError::ALREADY_UNUSED);
+
+	(void)Replace(pos, std::forward<Args>(args)...);
+	objectsInUse--;
+	stats.OnRelease();
+	observer.OnUnUse(pos);
+	return {};
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::TResultVoid CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::UnUseRange(const size_t pos, const size_t count) noexcept
+{
+	if (pos >= poolSize || count > poolSize - pos)
+		return std::unexpected(EPoolError::OUT_OF_RANGE);
+	if (Detail::FindFlag(inUse.data(), pos, pos + count, Detail::FLAG_FREE) != pos + count)
+		return std::unexpected(EPoolError::ALREADY_UNUSED);
+
+	for (size_t idx = pos; idx < pos + count; ++idx)
+		(void)UnUse(idx);
+	return {};
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::TResultVoid CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::Replace(const size_t pos) noexcept
+{
+	if (pos >= poolSize)
+		return std::unexpected(EPoolError::OUT_OF_RANGE);
+
+	std::destroy_at(std::launder(reinterpret_cast<T*>(&pool[pos].object)));
+	::new(&pool[pos].object) T();
+	MarkChanged(pos);
+	if (inUse[pos])
+		MarkFree(pos);
+	observer.OnReplace(pos);
+	return {};
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+template <typename... Args>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::TResultVoid CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::Replace(const size_t pos, Args&&... args) noexcept
+{
+	if (pos >= poolSize)
+		return std::unexpected(EPoolError::OUT_OF_RANGE);
+
+	std::destroy_at(std::launder(reinterpret_cast<T*>(&pool[pos].object)));
+	::new(&pool[pos].object) T(std::forward<Args>(args)...);
+	MarkChanged(pos);
+	if (inUse[pos])
+		MarkFree(pos);
+	observer.OnReplace(pos);
+	return {};
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::CIterator CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::begin()
+{
+	MarkActiveChanged();
+	return CIterator(this, CIterator::B_BEGIN);
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::CIterator CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::end()
+{
+	return CIterator(this, CIterator::B_END);
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::CConstIterator CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::begin() const
+{
+	return CConstIterator(this, CConstIterator::B_BEGIN);
+}
 
-	/**
-	 * @brief Returns begin iterator spanning all *active* elements in the pool.
-	 *
-	 * Iteration skips unused slots and supports STL algorithms and C++23 ranges.
-	 * Example:
-	 * ```cpp
-	 * for (auto& obj : myPool)
-	 *     obj.Update();
-	 * ```
-	 */
-	CIterator begin();
-	/** @brief Returns end iterator pointing one past the last element. */
-	CIterator end();
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::CConstIterator CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::end() const
+{
+	return CConstIterator(this, CConstIterator::B_END);
+}
 
-	/** @brief Returns the total number of slots in the pool. */
-	[[nodiscard]]
-	size_t Size() const noexcept;
-	/** @brief Returns the number of currently active (used) objects. */
-	[[nodiscard]]
-	size_t ObjectsInUse() const noexcept;
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::CConstIterator CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::cbegin() const
+{
+	return begin();
+}
 
-protected:
-	/** @brief Abstract byte object for storing T in the object pool and marking its state. */
-	struct CObject
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::CConstIterator CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::cend() const
+{
+	return end();
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+template <typename TExecutionPolicy, typename TFunc>
+	requires std::is_execution_policy_v<std::remove_cvref_t<TExecutionPolicy>>
+void CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::ForEachActive(TExecutionPolicy&& policy, TFunc&& func)
+{
+	MarkActiveChanged();
+	// first slot starting on a cache line, all further chunk boundaries are PARALLEL_CHUNK apart
+	const auto address = reinterpret_cast<uintptr_t>(pool);
+	size_t firstAligned = 0;
+	while (firstAligned < Detail::CACHE_LINE_SIZE
+	       && (address + firstAligned * sizeof(CObject)) % Detail::CACHE_LINE_SIZE != 0)
+		++firstAligned;
+	if (firstAligned == Detail::CACHE_LINE_SIZE) // no slot starts on a line, chunks can't avoid sharing one
+		firstAligned = 0;
+	firstAligned = std::min(firstAligned, poolSize);
+
+	// chunk `idx` is the unaligned head (if any) or one of the PARALLEL_CHUNK runs after it
+	const size_t headChunks = firstAligned > 0 ? 1 : 0;
+	const size_t chunkCount = headChunks + (poolSize - firstAligned + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK;
+	// the parallel algorithms only split ranges of forward iterators with a real reference (an
+	// iota view falls back to a sequential loop), so the first `chunkCount` usage flags serve as
+	// the chunk indices; there are never more chunks than slots and nothing is allocated
+	const uint8_t* pFirst = inUse.data();
+	std::for_each(std::forward<TExecutionPolicy>(policy), pFirst, pFirst + chunkCount,
+	              [this, &func, pFirst, firstAligned, headChunks](const uint8_t& chunk)
+	              {
+		              const auto idx = static_cast<size_t>(&chunk - pFirst);
+		              const size_t chunkBegin = idx < headChunks ? 0 : firstAligned + (idx - headChunks) * PARALLEL_CHUNK;
+		              const size_t chunkEnd = idx < headChunks ? firstAligned : std::min(poolSize, chunkBegin + PARALLEL_CHUNK);
+		              for (size_t pos = chunkBegin; pos < chunkEnd; ++pos)
+		              {
+			              if (inUse[pos])
+				              func(*std::launder(reinterpret_cast<T*>(&pool[pos].object)));
+		              }
+	              });
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+template <typename TFunc>
+void CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::ForEachActive(TFunc&& func)
+{
+	MarkActiveChanged();
+	// only visit blocks with used slots, but check every slot inside, which is cheaper than searching
+	for (size_t block = usedBlocks.FindFirst(0); block < usedBlocks.BlockCount(); block = usedBlocks.FindFirst(block + 1))
 	{
-		bool bInUse = false;
-		alignas(T) std::byte object[sizeof(T)]{};
-	};
+		const size_t blockEnd = std::min(poolSize, (block + 1) * Detail::BLOCK_SIZE);
+		for (size_t pos = block * Detail::BLOCK_SIZE; pos < blockEnd; ++pos)
+		{
+			if (inUse[pos])
+				func(*std::launder(reinterpret_cast<T*>(&pool[pos].object)));
+		}
+	}
+}
 
-	/** @brief updates class member `nextIdx` with the next unused index. */
-	void UpdateNextIdx();
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::CRunView CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::Runs()
+{
+	MarkActiveChanged();
+	return CRunView(this);
+}
 
-	const size_t poolSize;
-	size_t nextIdx;
-	size_t objectsInUse;
-	std::vector<CObject> pool;
-};
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::CSlotView CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::Slots()
+{
+	// slot views also reach the free slots
+	MarkAllChanged();
+	return CSlotView(this);
+}
 
-// implementation
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::CConstSlotView CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::Slots() const
+{
+	return CConstSlotView(this);
+}
 
-template <pool_object T>
-CObjectPool<T>::CObjectPool(const size_t size)
-	: poolSize(size),
-	  nextIdx(0),
-	  objectsInUse(0),
-	  pool(std::vector<CObject>(size))
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+template <typename TFunc>
+	requires std::move_constructible<T> && std::invocable<TFunc&, size_t, size_t>
+size_t CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::Compact(TFunc&& on_relocate)
 {
-	for (size_t pos = 0; pos < poolSize; ++pos)
+	size_t moved = 0;
+	size_t freePos = FindFree(0);
+	size_t usedPos = FindUsedBackward(poolSize);
+	// `usedPos == poolSize` if no slot is in use
+	while (freePos < usedPos && usedPos != poolSize)
 	{
-		// construct value in memory of aligned storage
-		// using in place operator new
-		::new(&pool[pos].object) T();
+		T* pSource = std::launder(reinterpret_cast<T*>(&pool[usedPos].object));
+		std::destroy_at(std::launder(reinterpret_cast<T*>(&pool[freePos].object)));
+		::new(&pool[freePos].object) T(std::move(*pSource));
+		std::destroy_at(pSource);
+		::new(&pool[usedPos].object) T();
+		MarkUsed(freePos);
+		MarkFree(usedPos);
+
+		if constexpr (relocation_observer<TObserver>)
+			observer.OnRelocate(usedPos, freePos);
+		on_relocate(usedPos, freePos);
+		++moved;
+
+		freePos = FindFree(freePos + 1);
+		usedPos = FindUsedBackward(usedPos);
 	}
+	// the used slots form the prefix now
+	nextIdx = objectsInUse < poolSize ? objectsInUse : nextIdx;
+	return moved;
 }
 
-template <pool_object T>
-template <typename... Args>
-CObjectPool<T>::CObjectPool(const size_t size, Args&&... args)
-	: poolSize(size),
-	  nextIdx(0),
-	  objectsInUse(0),
-	  pool(std::vector<CObject>())
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+std::vector<size_t> CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::Compact() requires std::move_constructible<T>
 {
-	pool.resize(size);
-	for (size_t pos = 0; pos < poolSize; ++pos)
+	std::vector<size_t> remap(poolSize);
+	std::iota(remap.begin(), remap.end(), size_t(0));
+	(void)Compact([&remap](const size_t old_pos, const size_t new_pos)
 	{
-		// construct value in memory of aligned storage
-		// using in place operator new
-		::new(&pool[pos].object) T(std::forward<Args>(args)...);
-	}
+		remap[old_pos] = new_pos;
+	});
+	return remap;
 }
 
-template <pool_object T>
-CObjectPool<T>::~CObjectPool()
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+void CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::Snapshot(CSnapshot& snapshot) const requires std::is_trivially_copyable_v<T>
 {
-	for (size_t pos = 0; pos < poolSize; ++pos)
-		std::destroy_at(std::addressof(pool[pos].object));
+	snapshot.objects.resize(poolSize * sizeof(CObject));
+	if (poolSize != 0)
+		std::memcpy(snapshot.objects.data(), pool, poolSize * sizeof(CObject));
+	// equally sized vectors are assigned in place, so a reused snapshot doesn't allocate
+	snapshot.inUse = inUse;
+	snapshot.freePrev = freePrev;
+	snapshot.freeNext = freeNext;
+	CopyAllocState(snapshot);
 }
 
-template <pool_object T>
-T* CObjectPool<T>::operator[](const size_t pos) noexcept
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::CSnapshot CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::Snapshot() const requires std::is_trivially_copyable_v<T>
 {
-	return std::launder(reinterpret_cast<T*>(&pool[pos].object));
+	CSnapshot snapshot;
+	Snapshot(snapshot);
+	return snapshot;
 }
 
-template <pool_object T>
-CObjectPool<T>::TResult CObjectPool<T>::Use(const size_t pos) noexcept
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+size_t CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::SnapshotDelta(CSnapshot& snapshot) const requires std::is_trivially_copyable_v<T>
 {
-	if (pos >= poolSize)
+	if (snapshot.poolId != poolId || snapshot.Size() != poolSize)
+	{
+		Snapshot(snapshot);
+		return poolSize;
+	}
+
+	size_t copied = 0;
+	for (size_t block = 0; block < blockStamps.size(); ++block)
+	{
+		if (!IsBlockChanged(block, snapshot.stamp))
+			continue;
+		CopyBlock(snapshot, block);
+		copied += std::min(poolSize, (block + 1) * Detail::BLOCK_SIZE) - block * Detail::BLOCK_SIZE;
+	}
+	CopyAllocState(snapshot);
+	return copied;
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::TResultVoid CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::Restore(const CSnapshot& snapshot) requires std::is_trivially_copyable_v<T>
+{
+	if (snapshot.Size() != poolSize)
 		return std::unexpected(EPoolError::OUT_OF_RANGE);
 
-	if (pool[pos].bInUse)
-		return std::unexpected(EPoolError::ALREADY_IN_USE);
+	for (size_t block = 0; block < blockStamps.size(); ++block)
+		(void)RestoreBlock(snapshot, block);
+	RestoreAllocState(snapshot);
+	return {};
+}
 
-	pool[pos].bInUse = true;
-	UpdateNextIdx();
-	objectsInUse++;
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+std::expected<size_t, EPoolError> CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::RestoreDelta(const CSnapshot& snapshot) requires std::is_trivially_copyable_v<T>
+{
+	if (snapshot.Size() != poolSize)
+		return std::unexpected(EPoolError::OUT_OF_RANGE);
+	if (snapshot.poolId != poolId)
+	{
+		(void)Restore(snapshot);
+		return poolSize;
+	}
+
+	size_t copied = 0;
+	for (size_t block = 0; block < blockStamps.size(); ++block)
+	{
+		if (IsBlockChanged(block, snapshot.stamp))
+			copied += RestoreBlock(snapshot, block);
+	}
+	RestoreAllocState(snapshot);
+	return copied;
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+T* CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::ObjectAt(const size_t pos) noexcept
+{
 	return std::launder(reinterpret_cast<T*>(&pool[pos].object));
 }
 
-template <pool_object T>
-CObjectPool<T>::TResult CObjectPool<T>::UseNext(size_t& found_pos) noexcept
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+const T* CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::ObjectAt(const size_t pos) const noexcept
 {
-	for (size_t pos = nextIdx, idx = 0; idx < poolSize; ++pos, pos %= poolSize, ++idx)
-	{
-		if (pool[pos].bInUse)
-			continue;
+	return std::launder(reinterpret_cast<const T*>(&pool[pos].object));
+}
 
-		pool[pos].bInUse = true;
-		found_pos = pos;
-		UpdateNextIdx();
-		objectsInUse++;
-		return std::launder(reinterpret_cast<T*>(&pool[pos].object));
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+void CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::MarkChanged(const size_t pos) noexcept
+{
+	if constexpr (B_TRACK_CHANGES)
+	{
+		std::atomic_ref(blockStamps[pos / Detail::BLOCK_SIZE]).store(changeStamp.load(std::memory_order_relaxed),
+		                                                            std::memory_order_relaxed);
 	}
-	return std::unexpected(EPoolError::FULL);
 }
 
-template <pool_object T>
-CObjectPool<T>::TResult CObjectPool<T>::UseNextReplace(size_t& found_pos) noexcept
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+void CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::MarkActiveChanged() noexcept
 {
-	for (size_t pos = nextIdx, idx = 0; idx < poolSize; ++pos, pos %= poolSize, ++idx)
+	if constexpr (B_TRACK_CHANGES)
 	{
-		if (pool[pos].bInUse)
-			continue;
+		const uint64_t stamp = changeStamp.load(std::memory_order_relaxed);
+		for (size_t block = usedBlocks.FindFirst(0); block < usedBlocks.BlockCount(); block = usedBlocks.FindFirst(block + 1))
+			std::atomic_ref(blockStamps[block]).store(stamp, std::memory_order_relaxed);
+	}
+}
 
-		if (auto result = Replace(pos); !result.has_value())
-			[[unlikely]] // Replace only returns error out of bounds
-			return std::unexpected(result.error());
-		pool[pos].bInUse = true;
-		found_pos = pos;
-		objectsInUse++;
-		UpdateNextIdx();
-		return std::launder(reinterpret_cast<T*>(&pool[pos].object));
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+void CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::MarkAllChanged() noexcept
+{
+	if constexpr (B_TRACK_CHANGES)
+		std::atomic_ref(allChangedStamp).store(changeStamp.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+bool CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::IsBlockChanged(const size_t block, const uint64_t stamp) const noexcept
+{
+	return std::max(blockStamps[block], allChangedStamp) > stamp;
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+void CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::CopyBlock(CSnapshot& snapshot, const size_t block) const noexcept
+{
+	const size_t blockBegin = block * Detail::BLOCK_SIZE;
+	const size_t blockEnd = std::min(poolSize, blockBegin + Detail::BLOCK_SIZE);
+	std::memcpy(snapshot.objects.data() + blockBegin * sizeof(CObject), &pool[blockBegin],
+	            (blockEnd - blockBegin) * sizeof(CObject));
+	std::copy(inUse.begin() + blockBegin, inUse.begin() + blockEnd, snapshot.inUse.begin() + blockBegin);
+	if constexpr (!B_FREE_SUMMARY)
+	{
+		std::copy(freePrev.begin() + blockBegin, freePrev.begin() + blockEnd, snapshot.freePrev.begin() + blockBegin);
+		std::copy(freeNext.begin() + blockBegin, freeNext.begin() + blockEnd, snapshot.freeNext.begin() + blockBegin);
 	}
-	return std::unexpected(EPoolError::FULL);
 }
 
-template <pool_object T>
-template <typename... Args>
-CObjectPool<T>::TResult CObjectPool<T>::UseNextReplace(size_t& found_pos, Args&&... args) noexcept
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+size_t CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::RestoreBlock(const CSnapshot& snapshot, const size_t block) noexcept
 {
-	for (size_t pos = nextIdx, idx = 0; idx < poolSize; ++pos, pos %= poolSize, ++idx)
+	const size_t blockBegin = block * Detail::BLOCK_SIZE;
+	const size_t blockEnd = std::min(poolSize, blockBegin + Detail::BLOCK_SIZE);
+	for (size_t pos = blockBegin; pos < blockEnd; ++pos)
 	{
-		if (pool[pos].bInUse)
+		const std::byte* pSource = snapshot.objects.data() + pos * sizeof(CObject);
+		const bool bObjectChanged = std::memcmp(&pool[pos], pSource, sizeof(CObject)) != 0;
+		std::memcpy(&pool[pos], pSource, sizeof(CObject));
+		if (inUse[pos] == snapshot.inUse[pos])
+		{
+			if (bObjectChanged)
+				observer.OnReplace(pos);
 			continue;
+		}
 
-		if (auto result = Replace(pos, std::forward<Args>(args)...); !result.has_value())
-			[[unlikely]] // Replace only returns error out of bounds
-			return std::unexpected(result.error());
-		pool[pos].bInUse = true;
-		found_pos = pos;
-		objectsInUse++;
-		UpdateNextIdx();
-		return std::launder(reinterpret_cast<T*>(&pool[pos].object));
+		inUse[pos] = snapshot.inUse[pos];
+		if (inUse[pos])
+		{
+			objectsInUse++;
+			stats.OnAcquire(objectsInUse);
+			observer.OnUse(pos);
+		}
+		else
+		{
+			objectsInUse--;
+			stats.OnRelease();
+			observer.OnUnUse(pos);
+		}
+	}
+	if constexpr (!B_FREE_SUMMARY)
+	{
+		std::copy(snapshot.freePrev.begin() + blockBegin, snapshot.freePrev.begin() + blockEnd, freePrev.begin() + blockBegin);
+		std::copy(snapshot.freeNext.begin() + blockBegin, snapshot.freeNext.begin() + blockEnd, freeNext.begin() + blockBegin);
 	}
-	return std::unexpected(EPoolError::FULL);
+	// the block differs from other snapshots now
+	MarkChanged(blockBegin);
+	return blockEnd - blockBegin;
 }
 
-template <pool_object T>
-CObjectPool<T>::TResult CObjectPool<T>::Get(const size_t pos) noexcept
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+void CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::CopyAllocState(CSnapshot& snapshot) const
 {
-	if (pos >= poolSize)
-		return std::unexpected(EPoolError::OUT_OF_RANGE);
-	if (!pool[pos].bInUse)
-		return std::unexpected(EPoolError::NOT_IN_USE);
-	return std::launder(reinterpret_cast<T*>(&pool[pos].object));
+	snapshot.usedBlocks = usedBlocks;
+	snapshot.freeBlocks = freeBlocks;
+	snapshot.freeHead = freeHead;
+	snapshot.nextIdx = nextIdx;
+	snapshot.objectsInUse = objectsInUse;
+	snapshot.poolId = poolId;
+	// later writes are stamped with the next epoch
+	snapshot.stamp = changeStamp.fetch_add(1, std::memory_order_relaxed);
 }
 
-template <pool_object T>
-CObjectPool<T>::TResultConst CObjectPool<T>::Get(const size_t pos) const noexcept
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+void CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::RestoreAllocState(const CSnapshot& snapshot)
 {
-	if (pos >= poolSize)
-		return std::unexpected(EPoolError::OUT_OF_RANGE);
-	if (!pool[pos].bInUse)
-		return std::unexpected(EPoolError::NOT_IN_USE);
-	return std::launder(reinterpret_cast<const T*>(&pool[pos].object));
+	usedBlocks = snapshot.usedBlocks;
+	freeBlocks = snapshot.freeBlocks;
+	freeHead = snapshot.freeHead;
+	nextIdx = snapshot.nextIdx;
+	objectsInUse = snapshot.objectsInUse;
 }
 
-template <pool_object T>
-bool CObjectPool<T>::IsInUse(const size_t pos) const noexcept
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+size_t CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::Size() const noexcept
 {
-	if (pos >= poolSize)
-		return false;
-	return pool[pos].bInUse;
+	return poolSize;
 }
 
-template <pool_object T>
-CObjectPool<T>::TResultVoid CObjectPool<T>::UnUse(const size_t pos) noexcept
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+size_t CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::ObjectsInUse() const noexcept
 {
-	if (pos >= poolSize)
-		return std::unexpected(EPoolError::OUT_OF_RANGE);
-	if (!pool[pos].bInUse)
-		return std::unexpected(EPoolError::ALREADY_UNUSED);
+	return objectsInUse;
+}
 
-	(void)Replace(pos);
-	objectsInUse--;
-	return {};
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+const TStats& CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::Stats() const noexcept
+{
+	return stats;
 }
 
-template <pool_object T>
-template <typename... Args>
-CObjectPool<T>::TResultVoid CObjectPool<T>::UnUse(const size_t pos, Args&&... args) noexcept
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+TStats& CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::Stats() noexcept
 {
-	if (pos >= poolSize)
-		return std::unexpected(EPoolError::OUT_OF_RANGE);
-	if (!pool[pos].bInUse)
-		return std::unexpected(EPoolError::ALREADY_UNUSED);
+	return stats;
+}
 
-	(void)Replace(pos, std::forward<Args>(args)...);
-	objectsInUse--;
-	return {};
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+const TObserver& CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::Observer() const noexcept
+{
+	return observer;
 }
 
-template <pool_object T>
-CObjectPool<T>::TResultVoid CObjectPool<T>::Replace(const size_t pos) noexcept
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+TObserver& CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::Observer() noexcept
 {
-	if (pos >= poolSize)
-		return std::unexpected(EPoolError::OUT_OF_RANGE);
+	return observer;
+}
 
-	std::destroy_at(std::launder(reinterpret_cast<T*>(&pool[pos].object)));
-	::new(&pool[pos].object) T();
-	pool[pos].bInUse = false;
-	return {};
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+constexpr size_t CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::BufferSize(const size_t size) noexcept
+{
+	return size * sizeof(CObject);
 }
 
-template <pool_object T>
-template <typename... Args>
-CObjectPool<T>::TResultVoid CObjectPool<T>::Replace(const size_t pos, Args&&... args) noexcept
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+std::span<typename CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::CObject> CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::SlotsIn(const std::span<std::byte> buffer) noexcept
 {
-	if (pos >= poolSize)
-		return std::unexpected(EPoolError::OUT_OF_RANGE);
+	void* pStart = buffer.data();
+	size_t space = buffer.size();
+	if (std::align(alignof(CObject), sizeof(CObject), pStart, space) == nullptr)
+		return {};
+	return std::span<CObject>(static_cast<CObject*>(pStart), space / sizeof(CObject));
+}
 
-	std::destroy_at(std::launder(reinterpret_cast<T*>(&pool[pos].object)));
-	::new(&pool[pos].object) T(std::forward<Args>(args)...);
-	pool[pos].bInUse = false;
-	return {};
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+TObserver CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::MakeObserver(const size_t size)
+{
+	if constexpr (capacity_constructible<TObserver>)
+		return TObserver(size);
+	else
+		return TObserver();
 }
 
-template <pool_object T>
-CObjectPool<T>::CIterator CObjectPool<T>::begin()
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+size_t CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::FindNextFree() noexcept
 {
-	return CIterator(this, CIterator::B_BEGIN);
+	size_t scanned = 0;
+	size_t pos;
+	if constexpr (ALLOC_POLICY == EAllocPolicy::LOWEST_FREE)
+	{
+		pos = FindSummarized(freeBlocks, Detail::FLAG_FREE, 0, scanned);
+	}
+	else if constexpr (ALLOC_POLICY == EAllocPolicy::MOST_RECENTLY_FREED)
+	{
+		pos = freeHead != NO_SLOT ? freeHead : poolSize;
+		scanned = freeHead != NO_SLOT ? 1 : 0;
+	}
+	else
+	{
+		pos = FindFreeWrapped(nextIdx, scanned);
+	}
+	stats.OnScan(scanned);
+	return pos;
 }
 
-template <pool_object T>
-CObjectPool<T>::CIterator CObjectPool<T>::end()
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+void CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::UpdateNextIdx() noexcept
 {
-	return CIterator(this, CIterator::B_END);
+	if constexpr (ALLOC_POLICY == EAllocPolicy::ROUND_ROBIN)
+	{
+		// keep `nextIdx` if the pool is full
+		if (const size_t pos = FindFreeWrapped(nextIdx); pos != poolSize)
+			nextIdx = pos;
+	}
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+size_t CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::FindSummarized(const Detail::CBlockSummary& summary, const uint8_t value, const size_t from) const noexcept
+{
+	size_t scanned = 0;
+	return FindSummarized(summary, value, from, scanned);
 }
 
-template <pool_object T>
-size_t CObjectPool<T>::Size() const noexcept
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+size_t CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::FindSummarized(const Detail::CBlockSummary& summary, const uint8_t value, const size_t from, size_t& scanned) const noexcept
 {
+	// a full block worth of flags behind `from` first, short ranges would miss the SIMD path
+	const size_t windowEnd = std::min(poolSize, from + Detail::BLOCK_SIZE);
+	if (const size_t pos = Detail::FindFlag(inUse.data(), from, windowEnd, value); pos != windowEnd || windowEnd == poolSize)
+	{
+		scanned += std::min(pos + 1, windowEnd) - std::min(from, windowEnd);
+		return pos;
+	}
+	scanned += windowEnd - from;
+
+	// at most two blocks are visited: the one partly covered by the window may not match
+	for (size_t block = summary.FindFirst(windowEnd / Detail::BLOCK_SIZE); block < summary.BlockCount(); block = summary.FindFirst(block + 1))
+	{
+		const size_t blockBegin = std::max(windowEnd, block * Detail::BLOCK_SIZE);
+		const size_t blockEnd = std::min(poolSize, (block + 1) * Detail::BLOCK_SIZE);
+		const size_t pos = Detail::FindFlag(inUse.data(), blockBegin, blockEnd, value);
+		scanned += std::min(pos + 1, blockEnd) - blockBegin;
+		if (pos != blockEnd)
+			return pos;
+	}
 	return poolSize;
 }
 
-template <pool_object T>
-size_t CObjectPool<T>::ObjectsInUse() const noexcept
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+size_t CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::FindSummarizedBackward(const Detail::CBlockSummary& summary, const uint8_t value, const size_t to) const noexcept
 {
-	return objectsInUse;
+	const size_t windowBegin = to > Detail::BLOCK_SIZE ? to - Detail::BLOCK_SIZE : 0;
+	if (const size_t pos = Detail::FindFlagBackward(inUse.data(), windowBegin, to, value); pos != to || windowBegin == 0)
+		return pos;
+
+	const size_t firstOutside = (windowBegin + Detail::BLOCK_SIZE - 1) / Detail::BLOCK_SIZE;
+	for (size_t block = summary.FindLast(firstOutside); block < summary.BlockCount(); block = summary.FindLast(block))
+	{
+		const size_t blockBegin = block * Detail::BLOCK_SIZE;
+		const size_t blockEnd = std::min(windowBegin, blockBegin + Detail::BLOCK_SIZE);
+		if (const size_t pos = Detail::FindFlagBackward(inUse.data(), blockBegin, blockEnd, value); pos != blockEnd)
+			return pos;
+	}
+	return to;
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+size_t CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::FindUsed(const size_t from) const noexcept
+{
+	return FindSummarized(usedBlocks, Detail::FLAG_USED, from);
 }
 
-template <pool_object T>
-void CObjectPool<T>::UpdateNextIdx()
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+size_t CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::FindUsedBackward(const size_t to) const noexcept
 {
-	for (size_t pos = nextIdx, idx = 0; idx < poolSize; ++pos, pos %= poolSize, ++idx)
+	return FindSummarizedBackward(usedBlocks, Detail::FLAG_USED, to);
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+size_t CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::FindFreeWrapped(const size_t start) const noexcept
+{
+	size_t scanned = 0;
+	return FindFreeWrapped(start, scanned);
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+size_t CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::FindFreeWrapped(const size_t start, size_t& scanned) const noexcept
+{
+	if constexpr (B_FREE_SUMMARY)
 	{
-		if (pool[pos].bInUse)
-			continue;
+		if (const size_t pos = FindSummarized(freeBlocks, Detail::FLAG_FREE, start, scanned); pos != poolSize)
+			return pos;
+		// nothing free in `[start, poolSize)`, so a hit is always before `start`
+		return FindSummarized(freeBlocks, Detail::FLAG_FREE, 0, scanned);
+	}
+	else
+	{
+		const size_t pos = Detail::FindFlagWrapped(inUse.data(), poolSize, start, Detail::FLAG_FREE);
+		scanned += pos == poolSize ? poolSize : (pos >= start ? pos - start : poolSize - start + pos) + 1;
+		return pos;
+	}
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+size_t CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::FindFreeNear(const size_t hint) const noexcept
+{
+	if constexpr (B_FREE_SUMMARY)
+	{
+		const size_t after = FindSummarized(freeBlocks, Detail::FLAG_FREE, hint);
+		if (after == hint)
+			return after;
+		const size_t before = FindSummarizedBackward(freeBlocks, Detail::FLAG_FREE, hint);
+		if (before == hint)
+			return after;
+		if (after == poolSize)
+			return before;
+		return hint - before < after - hint ? before : after;
+	}
+	else
+	{
+		// no free summary, widen a window `[hint - radius, hint + radius]` until it contains a free slot;
+		// both sides cover the same distances and all slots closer than the previous radius were
+		// already searched, so the nearer hit is final
+		size_t begin = hint;
+		size_t end = hint;
+		for (size_t radius = Detail::BLOCK_SIZE; begin > 0 || end < poolSize; radius *= 2)
+		{
+			const size_t newBegin = hint > radius ? hint - radius : 0;
+			const size_t newEnd = std::min(poolSize, hint + radius + 1);
+			const size_t after = Detail::FindFlag(inUse.data(), end, newEnd, Detail::FLAG_FREE);
+			const size_t before = Detail::FindFlagBackward(inUse.data(), newBegin, begin, Detail::FLAG_FREE);
+			if (before == begin)
+			{
+				if (after != newEnd)
+					return after;
+			}
+			else if (after == newEnd || hint - before < after - hint)
+			{
+				return before;
+			}
+			else
+			{
+				return after;
+			}
+			begin = newBegin;
+			end = newEnd;
+		}
+		return poolSize;
+	}
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+size_t CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::FindFree(const size_t from) const noexcept
+{
+	if constexpr (B_FREE_SUMMARY)
+		return FindSummarized(freeBlocks, Detail::FLAG_FREE, from);
+	else
+		return Detail::FindFlag(inUse.data(), from, poolSize, Detail::FLAG_FREE);
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+size_t CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::FindFreeRun(const size_t count) const noexcept
+{
+	// alternate between the start of a free run and the used slot ending it
+	for (size_t runBegin = FindFree(0); count <= poolSize - runBegin;)
+	{
+		const size_t runEnd = FindUsed(runBegin);
+		if (runEnd - runBegin >= count)
+			return runBegin;
+		runBegin = FindFree(runEnd);
+	}
+	return poolSize;
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+void CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::MarkUsed(const size_t pos) noexcept
+{
+	MarkChanged(pos);
+	inUse[pos] = Detail::FLAG_USED;
+	const size_t block = pos / Detail::BLOCK_SIZE;
+	usedBlocks.Set(block);
+	if constexpr (B_FREE_SUMMARY)
+	{
+		const size_t blockBegin = block * Detail::BLOCK_SIZE;
+		const size_t blockEnd = std::min(poolSize, blockBegin + Detail::BLOCK_SIZE);
+		if (Detail::FindFlag(inUse.data(), blockBegin, blockEnd, Detail::FLAG_FREE) == blockEnd)
+			freeBlocks.Clear(block);
+	}
+	else
+	{
+		// unlink, `pos` can be anywhere in the list after `Use(pos)`
+		if (freePrev[pos] != NO_SLOT)
+		{
+			freeNext[freePrev[pos]] = freeNext[pos];
+			MarkChanged(freePrev[pos]);
+		}
+		else
+		{
+			freeHead = freeNext[pos];
+		}
+		if (freeNext[pos] != NO_SLOT)
+		{
+			freePrev[freeNext[pos]] = freePrev[pos];
+			MarkChanged(freeNext[pos]);
+		}
+	}
+}
+
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+void CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::MarkFree(const size_t pos) noexcept
+{
+	MarkChanged(pos);
+	inUse[pos] = Detail::FLAG_FREE;
+	const size_t block = pos / Detail::BLOCK_SIZE;
+	const size_t blockBegin = block * Detail::BLOCK_SIZE;
+	const size_t blockEnd = std::min(poolSize, blockBegin + Detail::BLOCK_SIZE);
+	if (Detail::FindFlag(inUse.data(), blockBegin, blockEnd, Detail::FLAG_USED) == blockEnd)
+		usedBlocks.Clear(block);
+	if constexpr (B_FREE_SUMMARY)
+	{
+		freeBlocks.Set(block);
+	}
+	else
+	{
+		// push front, so it is handed out next
+		freePrev[pos] = NO_SLOT;
+		freeNext[pos] = freeHead;
+		if (freeHead != NO_SLOT)
+		{
+			freePrev[freeHead] = pos;
+			MarkChanged(freeHead);
+		}
+		freeHead = pos;
+	}
+}
 
-		nextIdx = pos;
-		return;
+template <pool_object T, pool_stats TStats, pool_observer TObserver, EAllocPolicy ALLOC_POLICY>
+void CObjectPool<T, TStats, TObserver, ALLOC_POLICY>::InitAllocPolicy()
+{
+	const size_t blocks = (poolSize + Detail::BLOCK_SIZE - 1) / Detail::BLOCK_SIZE;
+	usedBlocks = Detail::CBlockSummary(blocks);
+	if constexpr (B_TRACK_CHANGES)
+		blockStamps.assign(blocks, 0);
+	if constexpr (B_FREE_SUMMARY)
+	{
+		freeBlocks = Detail::CBlockSummary(blocks);
+		for (size_t block = 0; block < blocks; ++block)
+			freeBlocks.Set(block);
+	}
+	else
+	{
+		// ascending order, so a fresh pool hands out 0, 1, 2, ... like the other policies
+		freePrev.resize(poolSize);
+		freeNext.resize(poolSize);
+		for (size_t pos = 0; pos < poolSize; ++pos)
+		{
+			freePrev[pos] = pos > 0 ? pos - 1 : NO_SLOT;
+			freeNext[pos] = pos + 1 < poolSize ? pos + 1 : NO_SLOT;
+		}
+		freeHead = poolSize > 0 ? 0 : NO_SLOT;
 	}
 }
 }
@@ -0,0 +1,439 @@
+// -----------------------------------------------------------------------------
+// CSharedObjectPool.hpp
+// Object pool in POSIX shared memory, so processes can hand objects to each
+// other by slot index without copying them.
+// Author: Daniel Contu (Migos) — https://github.com/AbsintheScripting
+// -----------------------------------------------------------------------------
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "CMappedObjectPool.hpp"
+
+namespace ObjectPool
+{
+/**
+ * @brief Header at the start of every shared pool segment.
+ *
+ * `magic` is written last by `CSharedObjectPool::Create`, so a process opening the
+ * segment concurrently either sees a fully initialized pool or `INVALID_HEADER`.
+ */
+struct CSharedPoolHeader
+{
+	/** @brief `"OBJSHM"` followed by two zero bytes, read as little-endian integer. */
+	static constexpr uint64_t MAGIC = 0x00004D48534A424FULL;
+	/** @brief Bumped whenever the segment layout changes. */
+	static constexpr uint32_t VERSION = 1;
+
+	std::atomic<uint64_t> magic;
+	uint32_t version;
+	uint32_t typeSize;
+	uint32_t typeAlign;
+	uint32_t reserved;
+	uint64_t capacity;
+	std::atomic<uint64_t> objectsInUse;
+	/** Bitmap word the last `UseNext` succeeded in, where the next search starts. */
+	std::atomic<uint64_t> nextWord;
+};
+
+/**
+ * @class CSharedObjectPool
+ * @brief Fixed-size object pool in a named POSIX shared memory segment, usable from several processes.
+ *
+ * The segment holds a `CSharedPoolHeader`, an occupancy bitmap of `std::atomic<uint64_t>`
+ * words (one bit per slot) and the objects:
+ *
+ * | header (64 B) | bitmap (`ceil(Size() / 64) * 8` B) | padding | objects (`Size() * sizeof(T)` B) |
+ *
+ * Slots are claimed with a compare-and-swap on their bitmap word and released with an
+ * atomic `fetch_and`, so acquire and release are lock-free and a process dying mid-call
+ * can't leave a lock behind. Every process maps the segment at its own address, so
+ * objects are exchanged as slot indices:
+ *
+ * ```cpp
+ * // ingest process
+ * auto pool = CSharedObjectPool<CMessage>::Create("/ingest", 65536);
+ * size_t id;
+ * if (auto result = pool->UseNext(id)) {
+ *     Parse(packet, **result);
+ *     write(pipeFd, &id, sizeof(id)); // the index is all that crosses the process boundary
+ * }
+ *
+ * // analytics process
+ * auto pool = CSharedObjectPool<CMessage>::Open("/ingest");
+ * read(pipeFd, &id, sizeof(id));
+ * Analyze(**pool->Get(id)); // read in place
+ * (void)pool->UnUse(id);
+ * ```
+ *
+ * The pool only synchronizes the occupancy: the object itself must be handed over
+ * through a channel that orders memory (a pipe, socket or futex does), and only the
+ * current owner of a slot may access its object. The segment outlives the processes
+ * until `Unlink` is called. Pools mapped before a `fork` are shared with the child.
+ *
+ * @tparam T Object type, must be trivially copyable since it is shared as raw bytes
+ *           and must not contain pointers into a process' address space.
+ */
+template <pool_object T>
+	requires std::is_trivially_copyable_v<T>
+class CSharedObjectPool
+{
+public:
+	using TResult = std::expected<T*, EPoolError>;
+	using TResultConst = std::expected<const T*, EPoolError>;
+	using TResultVoid = std::expected<void, EPoolError>;
+	using TResultPool = std::expected<CSharedObjectPool, EMappedPoolError>;
+
+	/**
+	 * @brief Creates the shared memory segment `name` and default-constructs `size` slots in it.
+	 *
+	 * @param name Segment name as for `shm_open`, e.g. `"/ingest"`.
+	 * @return The pool, or `OPEN_FAILED` (also if the segment already exists)/`MAPPING_FAILED`.
+	 */
+	[[nodiscard]]
+	static TResultPool Create(const std::string& name, size_t size) noexcept;
+	/**
+	 * @brief Maps the existing segment `name` created by `Create`.
+	 * @return The pool, or `OPEN_FAILED`/`MAPPING_FAILED`/`INVALID_HEADER`/`VERSION_MISMATCH`/`TYPE_MISMATCH`.
+	 */
+	[[nodiscard]]
+	static TResultPool Open(const std::string& name) noexcept;
+	/**
+	 * @brief Removes the segment name, the memory is released once every process unmapped it.
+	 * @return `true` if the segment existed.
+	 */
+	static bool Unlink(const std::string& name) noexcept;
+
+	/** @brief Returns the size of the segment backing a pool of `size` slots. */
+	[[nodiscard]]
+	static constexpr size_t SegmentSize(size_t size) noexcept;
+
+	/** @brief Takes over the mapping, `other` is left empty: `Size()` and `ObjectsInUse()` return 0. */
+	CSharedObjectPool(CSharedObjectPool&& other) noexcept;
+	/** @brief Exchanges the mappings, the previous one of this pool is unmapped with `other`. */
+	CSharedObjectPool& operator=(CSharedObjectPool&& other) noexcept;
+
+	/** @brief Provides direct, unchecked access to the element at `pos`. */
+	T* operator[](size_t pos) noexcept;
+	/** @brief Provides direct, unchecked read-only access to the element at `pos`. */
+	const T* operator[](size_t pos) const noexcept;
+
+	/**
+	 * @brief Claims a specific slot and returns a pointer to its object, reset with `T()`.
+	 * @return Pointer to the object, or `OUT_OF_RANGE`/`ALREADY_IN_USE`.
+	 */
+	[[nodiscard]]
+	TResult Use(size_t pos) noexcept;
+	/**
+	 * @brief Claims a free slot, starting the search at the word of the previous hit.
+	 *
+	 * @param[out] found_pos Receives the index of the claimed slot.
+	 * @return Pointer to the object reset with `T()`, or `FULL` if no slot is free.
+	 */
+	[[nodiscard]]
+	TResult UseNext(size_t& found_pos) noexcept;
+	/**
+	 * @brief Releases the slot, its object is reset with `T()` once the slot is claimed again.
+	 *
+	 * The release is claimed atomically, so of two `UnUse` calls for the same owned slot exactly
+	 * one succeeds and the other returns `ALREADY_UNUSED` without touching the object. A release
+	 * by a process which no longer owns the slot can't be told apart from the new owner's once
+	 * the slot was claimed again; only the owner may call `UnUse`.
+	 *
+	 * @return Empty `expected` on success, or `OUT_OF_RANGE`/`ALREADY_UNUSED`.
+	 */
+	TResultVoid UnUse(size_t pos) noexcept;
+	/** @brief Returns a pointer to the object at `pos` if it is in use, or `OUT_OF_RANGE`/`NOT_IN_USE`. */
+	[[nodiscard]]
+	TResult Get(size_t pos) noexcept;
+	/** @brief Returns a pointer to the object at `pos` if it is in use, or `OUT_OF_RANGE`/`NOT_IN_USE`. */
+	[[nodiscard]]
+	TResultConst Get(size_t pos) const noexcept;
+	/** @brief Checks whether the slot at `pos` is claimed by any process. */
+	[[nodiscard]]
+	bool IsInUse(size_t pos) const noexcept;
+
+	/** @brief Returns the total number of slots in the pool. */
+	[[nodiscard]]
+	size_t Size() const noexcept;
+	/** @brief Returns the number of slots claimed by all processes, may be outdated immediately. */
+	[[nodiscard]]
+	size_t ObjectsInUse() const noexcept;
+
+protected:
+	using TWord = std::atomic<uint64_t>;
+	// the bitmap is shared between processes, a lock-based fallback would not be
+	static_assert(TWord::is_always_lock_free);
+
+	/** @brief Space reserved for `CSharedPoolHeader`. */
+	static constexpr size_t HEADER_SIZE = Detail::CACHE_LINE_SIZE;
+	static_assert(sizeof(CSharedPoolHeader) <= HEADER_SIZE);
+	/** @brief Alignment of the object array within the segment. */
+	static constexpr size_t OBJECTS_ALIGNMENT = std::max(alignof(T), Detail::CACHE_LINE_SIZE);
+
+	explicit CSharedObjectPool(Detail::CMemoryMapping&& memory) noexcept;
+
+	/** @brief Returns the number of bitmap words of a pool with `size` slots, at least one. */
+	[[nodiscard]]
+	static constexpr size_t WordCount(size_t size) noexcept;
+	/** @brief Returns the segment offset of the object array of a pool with `size` slots. */
+	[[nodiscard]]
+	static constexpr size_t ObjectsOffset(size_t size) noexcept;
+
+	[[nodiscard]]
+	CSharedPoolHeader& Header() const noexcept;
+	[[nodiscard]]
+	TWord* Words() const noexcept;
+	[[nodiscard]]
+	T* Object(size_t pos) const noexcept;
+
+	Detail::CMemoryMapping mapping;
+	size_t poolSize = 0;
+};
+
+// implementation
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CSharedObjectPool<T>::CSharedObjectPool(Detail::CMemoryMapping&& memory) noexcept
+	: mapping(std::move(memory))
+{
+	poolSize = static_cast<size_t>(Header().capacity);
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CSharedObjectPool<T>::CSharedObjectPool(CSharedObjectPool&& other) noexcept
+	: mapping(std::move(other.mapping)),
+	  poolSize(std::exchange(other.poolSize, 0))
+{}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CSharedObjectPool<T>& CSharedObjectPool<T>::operator=(CSharedObjectPool&& other) noexcept
+{
+	mapping = std::move(other.mapping);
+	std::swap(poolSize, other.poolSize);
+	return *this;
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CSharedObjectPool<T>::TResultPool CSharedObjectPool<T>::Create(const std::string& name, const size_t size) noexcept
+{
+	const int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+	if (fd < 0)
+		return std::unexpected(EMappedPoolError::OPEN_FAILED);
+	auto memory = Detail::CMemoryMapping::Map(fd, SegmentSize(size), true);
+	::close(fd);
+	if (!memory.has_value())
+	{
+		::shm_unlink(name.c_str());
+		return std::unexpected(memory.error());
+	}
+
+	std::byte* pData = memory->Data();
+	auto* pHeader = ::new(pData) CSharedPoolHeader{};
+	pHeader->version = CSharedPoolHeader::VERSION;
+	pHeader->typeSize = static_cast<uint32_t>(sizeof(T));
+	pHeader->typeAlign = static_cast<uint32_t>(alignof(T));
+	pHeader->capacity = size;
+
+	const size_t words = WordCount(size);
+	auto* pWords = reinterpret_cast<TWord*>(pData + HEADER_SIZE);
+	for (size_t word = 0; word < words; ++word)
+		::new(pWords + word) TWord(0);
+	// the bits past the last slot stay set forever, so the search needs no bounds mask
+	if (const size_t tail = size % 64; tail != 0 || size == 0)
+		pWords[words - 1].store(~uint64_t{0} << tail, std::memory_order_relaxed);
+
+	std::byte* pObjects = pData + ObjectsOffset(size);
+	for (size_t pos = 0; pos < size; ++pos)
+		::new(pObjects + pos * sizeof(T)) T();
+	pHeader->magic.store(CSharedPoolHeader::MAGIC, std::memory_order_release);
+	return CSharedObjectPool(std::move(*memory));
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CSharedObjectPool<T>::TResultPool CSharedObjectPool<T>::Open(const std::string& name) noexcept
+{
+	const int fd = ::shm_open(name.c_str(), O_RDWR | O_CLOEXEC, 0600);
+	if (fd < 0)
+		return std::unexpected(EMappedPoolError::OPEN_FAILED);
+	auto memory = Detail::CMemoryMapping::Map(fd, 0, false);
+	::close(fd);
+	if (!memory.has_value())
+		return std::unexpected(memory.error());
+	if (memory->Size() < HEADER_SIZE)
+		return std::unexpected(EMappedPoolError::INVALID_HEADER);
+
+	const auto* pHeader = std::launder(reinterpret_cast<const CSharedPoolHeader*>(memory->Data()));
+	if (pHeader->magic.load(std::memory_order_acquire) != CSharedPoolHeader::MAGIC)
+		return std::unexpected(EMappedPoolError::INVALID_HEADER);
+	if (pHeader->version != CSharedPoolHeader::VERSION)
+		return std::unexpected(EMappedPoolError::VERSION_MISMATCH);
+	if (pHeader->typeSize != sizeof(T) || pHeader->typeAlign != alignof(T))
+		return std::unexpected(EMappedPoolError::TYPE_MISMATCH);
+	const auto capacity = static_cast<size_t>(pHeader->capacity);
+	if (capacity > (memory->Size() - HEADER_SIZE) / sizeof(T) || SegmentSize(capacity) != memory->Size())
+		return std::unexpected(EMappedPoolError::INVALID_HEADER);
+	return CSharedObjectPool(std::move(*memory));
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+bool CSharedObjectPool<T>::Unlink(const std::string& name) noexcept
+{
+	return ::shm_unlink(name.c_str()) == 0;
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+constexpr size_t CSharedObjectPool<T>::WordCount(const size_t size) noexcept
+{
+	return size == 0 ? 1 : (size + 63) / 64;
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+constexpr size_t CSharedObjectPool<T>::ObjectsOffset(const size_t size) noexcept
+{
+	const size_t bitmapEnd = HEADER_SIZE + WordCount(size) * sizeof(TWord);
+	return (bitmapEnd + OBJECTS_ALIGNMENT - 1) / OBJECTS_ALIGNMENT * OBJECTS_ALIGNMENT;
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+constexpr size_t CSharedObjectPool<T>::SegmentSize(const size_t size) noexcept
+{
+	return ObjectsOffset(size) + size * sizeof(T);
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+T* CSharedObjectPool<T>::operator[](const size_t pos) noexcept
+{
+	return Object(pos);
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+const T* CSharedObjectPool<T>::operator[](const size_t pos) const noexcept
+{
+	return Object(pos);
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CSharedObjectPool<T>::TResult CSharedObjectPool<T>::Use(const size_t pos) noexcept
+{
+	if (pos >= poolSize)
+		return std::unexpected(EPoolError::OUT_OF_RANGE);
+
+	const uint64_t bit = uint64_t{1} << (pos % 64);
+	// acquire: the previous owner's writes are visible before the object is reset
+	if (Words()[pos / 64].fetch_or(bit, std::memory_order_acquire) & bit)
+		return std::unexpected(EPoolError::ALREADY_IN_USE);
+	Header().objectsInUse.fetch_add(1, std::memory_order_relaxed);
+	return ::new(Object(pos)) T();
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CSharedObjectPool<T>::TResult CSharedObjectPool<T>::UseNext(size_t& found_pos) noexcept
+{
+	if (poolSize == 0)
+		return std::unexpected(EPoolError::FULL);
+	CSharedPoolHeader& header = Header();
+	TWord* pWords = Words();
+	const size_t words = WordCount(poolSize);
+	const size_t start = static_cast<size_t>(header.nextWord.load(std::memory_order_relaxed)) % words;
+	for (size_t step = 0; step < words; ++step)
+	{
+		const size_t word = start + step < words ? start + step : start + step - words;
+		uint64_t bits = pWords[word].load(std::memory_order_relaxed);
+		// retry within the word while other processes take its free bits
+		while (bits != ~uint64_t{0})
+		{
+			const uint64_t bit = uint64_t{1} << std::countr_one(bits);
+			if (pWords[word].compare_exchange_weak(bits, bits | bit, std::memory_order_acquire, std::memory_order_relaxed))
+			{
+				header.nextWord.store(word, std::memory_order_relaxed);
+				header.objectsInUse.fetch_add(1, std::memory_order_relaxed);
+				found_pos = word * 64 + static_cast<size_t>(std::countr_zero(bit));
+				return ::new(Object(found_pos)) T();
+			}
+		}
+	}
+	return std::unexpected(EPoolError::FULL);
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CSharedObjectPool<T>::TResultVoid CSharedObjectPool<T>::UnUse(const size_t pos) noexcept
+{
+	if (pos >= poolSize)
+		return std::unexpected(EPoolError::OUT_OF_RANGE);
+
+	// the release is claimed by clearing the bit, a second `UnUse` of the free slot sees it clear
+	// and never touches the object; release: the next owner sees all writes of this one
+	const uint64_t bit = uint64_t{1} << (pos % 64);
+	if ((Words()[pos / 64].fetch_and(~bit, std::memory_order_release) & bit) == 0)
+		return std::unexpected(EPoolError::ALREADY_UNUSED);
+	Header().objectsInUse.fetch_sub(1, std::memory_order_relaxed);
+	return {};
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CSharedObjectPool<T>::TResult CSharedObjectPool<T>::Get(const size_t pos) noexcept
+{
+	if (!IsInUse(pos))
+		return std::unexpected(pos >= poolSize ? EPoolError::OUT_OF_RANGE : EPoolError::NOT_IN_USE);
+	return Object(pos);
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CSharedObjectPool<T>::TResultConst CSharedObjectPool<T>::Get(const size_t pos) const noexcept
+{
+	if (!IsInUse(pos))
+		return std::unexpected(pos >= poolSize ? EPoolError::OUT_OF_RANGE : EPoolError::NOT_IN_USE);
+	return Object(pos);
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+bool CSharedObjectPool<T>::IsInUse(const size_t pos) const noexcept
+{
+	return pos < poolSize && (Words()[pos / 64].load(std::memory_order_acquire) >> (pos % 64)) & 1;
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+size_t CSharedObjectPool<T>::Size() const noexcept
+{
+	return poolSize;
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+size_t CSharedObjectPool<T>::ObjectsInUse() const noexcept
+{
+	// a moved-from pool has no header
+	return mapping.Data() != nullptr ? static_cast<size_t>(Header().objectsInUse.load(std::memory_order_relaxed)) : 0;
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CSharedPoolHeader& CSharedObjectPool<T>::Header() const noexcept
+{
+	return *std::launder(reinterpret_cast<CSharedPoolHeader*>(mapping.Data()));
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+CSharedObjectPool<T>::TWord* CSharedObjectPool<T>::Words() const noexcept
+{
+	return std::launder(reinterpret_cast<TWord*>(mapping.Data() + HEADER_SIZE));
+}
+
+template <pool_object T> requires std::is_trivially_copyable_v<T>
+T* CSharedObjectPool<T>::Object(const size_t pos) const noexcept
+{
+	return std::launder(reinterpret_cast<T*>(mapping.Data() + ObjectsOffset(poolSize)) + pos);
+}
+}
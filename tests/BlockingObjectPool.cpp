@@ -0,0 +1,207 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <deque>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "../include/CBlockingObjectPool.hpp"
+
+using namespace ObjectPool;
+
+namespace Tests::BlockingObjectPool
+{
+struct CConnection
+{
+	int32_t queries = 0;
+};
+
+TEST(BlockingObjectPool, UseNextFor_TimesOutWhenFull)
+{
+	CBlockingObjectPool<CConnection, CPoolStats> pool(1);
+	size_t idx;
+	ASSERT_TRUE(pool.UseNext(idx).has_value());
+	EXPECT_EQ(pool.UseNext(idx).error(), EPoolError::FULL);
+
+	const auto start = std::chrono::steady_clock::now();
+	const auto result = pool.UseNextFor(idx, std::chrono::milliseconds(20));
+	ASSERT_FALSE(result.has_value());
+	EXPECT_EQ(result.error(), EPoolError::FULL);
+	EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+	EXPECT_EQ(pool.WithLock([](const auto& inner) { return inner.Stats().FullFailures(); }), 2u);
+}
+
+TEST(BlockingObjectPool, UseNextWait_WokenByUnUse)
+{
+	CBlockingObjectPool<CConnection> pool(1);
+	size_t first;
+	const auto resultFirst = pool.UseNext(first);
+	ASSERT_TRUE(resultFirst.has_value());
+	resultFirst.value()->queries = 3;
+
+	std::atomic<bool> bAcquired = false;
+	size_t second = 42;
+	std::thread waiter([&]
+	{
+		const auto result = pool.UseNextWait(second);
+		EXPECT_TRUE(result.has_value());
+		bAcquired = true;
+	});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	EXPECT_FALSE(bAcquired.load());
+	ASSERT_TRUE(pool.UnUse(first).has_value());
+	waiter.join();
+
+	EXPECT_TRUE(bAcquired.load());
+	EXPECT_EQ(second, first);
+	const auto resultSecond = pool.Get(second);
+	ASSERT_TRUE(resultSecond.has_value());
+	EXPECT_EQ(resultSecond.value()->queries, 0);
+	EXPECT_EQ(pool.UnUse(3).error(), EPoolError::OUT_OF_RANGE);
+}
+
+TEST(BlockingObjectPool, LimitsConcurrency)
+{
+	constexpr size_t POOL_SIZE = 3;
+	constexpr int32_t THREADS = 8;
+	constexpr int32_t ROUNDS = 200;
+	CBlockingObjectPool<CConnection> pool(POOL_SIZE);
+	std::atomic<size_t> active = 0;
+	std::atomic<size_t> maxActive = 0;
+
+	std::vector<std::thread> workers;
+	for (int32_t thread = 0; thread < THREADS; ++thread)
+	{
+		workers.emplace_back([&]
+		{
+			for (int32_t round = 0; round < ROUNDS; ++round)
+			{
+				size_t idx;
+				auto result = pool.UseNextWait(idx);
+				ASSERT_TRUE(result.has_value());
+				const size_t now = ++active;
+				size_t seen = maxActive.load();
+				while (now > seen && !maxActive.compare_exchange_weak(seen, now))
+				{}
+				(*result)->queries++;
+				--active;
+				ASSERT_TRUE(pool.UnUse(idx).has_value());
+			}
+		});
+	}
+	for (auto& worker : workers)
+		worker.join();
+
+	EXPECT_LE(maxActive.load(), POOL_SIZE);
+	EXPECT_EQ(pool.ObjectsInUse(), 0u);
+}
+
+// Minimal eagerly started, fire-and-forget coroutine
+struct CTask
+{
+	struct promise_type
+	{
+		CTask get_return_object() { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+	};
+};
+
+CTask AcquireAndRecord(CBlockingObjectPool<CConnection>& pool, std::vector<int32_t>& order, const int32_t id, size_t& found_pos)
+{
+	auto result = co_await pool.AcquireAsync(found_pos);
+	if (!result.has_value())
+	{
+		// ASSERT_* can't return from a coroutine
+		ADD_FAILURE() << ToString(result.error());
+		co_return;
+	}
+	(*result)->queries = id;
+	order.push_back(id);
+}
+
+TEST(BlockingObjectPool, AcquireAsync_CompletesImmediately)
+{
+	CBlockingObjectPool<CConnection> pool(2);
+	std::vector<int32_t> order;
+	size_t idx = 42;
+	AcquireAndRecord(pool, order, 1, idx);
+	EXPECT_EQ(order, (std::vector<int32_t>{1}));
+	EXPECT_EQ(idx, 0u);
+	const auto result = pool.Get(0);
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(result.value()->queries, 1);
+}
+
+TEST(BlockingObjectPool, AcquireAsync_ResumedInFifoOrder)
+{
+	CBlockingObjectPool<CConnection> pool(1);
+	size_t held;
+	ASSERT_TRUE(pool.UseNext(held).has_value());
+
+	std::vector<int32_t> order;
+	std::array<size_t, 3> positions{};
+	for (int32_t id = 0; id < 3; ++id)
+		AcquireAndRecord(pool, order, id, positions[id]);
+	EXPECT_TRUE(order.empty());
+
+	// every release hands the slot to the oldest waiter and resumes it inline
+	ASSERT_TRUE(pool.UnUse(held).has_value());
+	EXPECT_EQ(order, (std::vector<int32_t>{0}));
+	size_t other;
+	EXPECT_EQ(pool.UseNext(other).error(), EPoolError::FULL);
+
+	ASSERT_TRUE(pool.UnUse(positions[0]).has_value());
+	ASSERT_TRUE(pool.UnUse(positions[1]).has_value());
+	EXPECT_EQ(order, (std::vector<int32_t>{0, 1, 2}));
+	EXPECT_EQ(pool.ObjectsInUse(), 1u);
+}
+
+TEST(BlockingObjectPool, AcquireAsync_ResumedOnExecutor)
+{
+	struct CQueueExecutor
+	{
+		std::deque<std::coroutine_handle<>>* pQueue;
+
+		void operator()(const std::coroutine_handle<> handle) const noexcept
+		{
+			pQueue->push_back(handle);
+		}
+	};
+	struct CThrowingExecutor
+	{
+		void operator()(std::coroutine_handle<>) const {}
+	};
+	// UnUse resumes through the executor and must not throw
+	static_assert(coroutine_executor<CQueueExecutor>);
+	static_assert(coroutine_executor<CInlineExecutor>);
+	static_assert(!coroutine_executor<CThrowingExecutor>);
+
+	CBlockingObjectPool<CConnection> pool(1);
+	size_t held;
+	ASSERT_TRUE(pool.UseNext(held).has_value());
+
+	std::deque<std::coroutine_handle<>> queue;
+	bool bResumed = false;
+	size_t found = 42;
+	[](CBlockingObjectPool<CConnection>& pool, CQueueExecutor executor, size_t& found_pos, bool& b_resumed) -> CTask
+	{
+		auto result = co_await pool.AcquireAsync(found_pos, executor);
+		EXPECT_TRUE(result.has_value());
+		b_resumed = true;
+	}(pool, CQueueExecutor{&queue}, found, bResumed);
+
+	ASSERT_TRUE(pool.UnUse(held).has_value());
+	// the slot is already handed over, but the coroutine only runs on the executor
+	EXPECT_FALSE(bResumed);
+	EXPECT_EQ(found, held);
+	ASSERT_EQ(queue.size(), 1u);
+	queue.front().resume();
+	EXPECT_TRUE(bResumed);
+}
+}
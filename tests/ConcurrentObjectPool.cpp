@@ -0,0 +1,319 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "../include/CConcurrentObjectPool.hpp"
+
+using namespace ObjectPool;
+
+namespace Tests::ConcurrentObjectPool
+{
+struct CEntity
+{
+	uint32_t id = 0;
+	uint32_t checksum = 0;
+};
+
+TEST(ConcurrentObjectPool, PublishMakesObjectVisible)
+{
+	CConcurrentObjectPool<CEntity> pool(4);
+	size_t idx;
+	auto result = pool.UseNext(idx);
+	ASSERT_TRUE(result.has_value());
+	(*result)->id = 7;
+
+	{
+		const auto guard = pool.Read();
+		EXPECT_FALSE(guard.IsInUse(idx));
+		EXPECT_EQ(guard.Get(idx).error(), EPoolError::NOT_IN_USE);
+	}
+
+	ASSERT_TRUE(pool.Publish(idx).has_value());
+	EXPECT_EQ(pool.Publish(idx).error(), EPoolError::ALREADY_IN_USE);
+	EXPECT_EQ(pool.Publish(3).error(), EPoolError::NOT_IN_USE);
+	EXPECT_EQ(pool.Publish(4).error(), EPoolError::OUT_OF_RANGE);
+
+	const auto guard = pool.Read();
+	ASSERT_TRUE(guard.IsInUse(idx));
+	const auto resultGet = guard.Get(idx);
+	ASSERT_TRUE(resultGet.has_value());
+	EXPECT_EQ(resultGet.value()->id, 7u);
+	size_t visited = 0;
+	guard.ForEachActive([&](const CEntity& entity)
+	{
+		EXPECT_EQ(entity.id, 7u);
+		++visited;
+	});
+	EXPECT_EQ(visited, 1u);
+	EXPECT_EQ(pool.ObjectsInUse(), 1u);
+}
+
+TEST(ConcurrentObjectPool, UnUseDefersResetWhileReading)
+{
+	CConcurrentObjectPool<CEntity> pool(1);
+	size_t idx;
+	auto result = pool.UseNext(idx);
+	ASSERT_TRUE(result.has_value());
+	result.value()->id = 42;
+	ASSERT_TRUE(pool.Publish(idx).has_value());
+
+	{
+		const auto guard = pool.Read();
+		const auto resultGet = guard.Get(idx);
+		ASSERT_TRUE(resultGet.has_value());
+		const CEntity* pEntity = resultGet.value();
+
+		ASSERT_TRUE(pool.UnUse(idx).has_value());
+		EXPECT_EQ(pool.UnUse(idx).error(), EPoolError::ALREADY_UNUSED);
+		EXPECT_EQ(pool.ObjectsInUse(), 0u);
+		EXPECT_EQ(pool.RetiredCount(), 1u);
+
+		// the reader still holds the object, so the slot can't be reused yet
+		EXPECT_EQ(pool.Reclaim(), 0u);
+		EXPECT_EQ(pool.UseNext(idx).error(), EPoolError::FULL);
+		EXPECT_EQ(pEntity->id, 42u);
+		// the guard still answers from its snapshot
+		EXPECT_TRUE(guard.IsInUse(idx));
+		EXPECT_FALSE(pool.Read().IsInUse(idx));
+	}
+
+	// the reader left, the next UseNext reclaims and resets the slot
+	result = pool.UseNext(idx);
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(result.value()->id, 0u);
+	EXPECT_EQ(pool.RetiredCount(), 0u);
+}
+
+TEST(ConcurrentObjectPool, ReclaimWithoutReaders)
+{
+	CConcurrentObjectPool<CEntity> pool(8);
+	for (size_t pos = 0; pos < 8; ++pos)
+	{
+		ASSERT_TRUE(pool.Use(pos).has_value());
+		ASSERT_TRUE(pool.Publish(pos).has_value());
+	}
+	EXPECT_EQ(pool.Use(3).error(), EPoolError::ALREADY_IN_USE);
+
+	for (size_t pos = 0; pos < 8; pos += 2)
+		ASSERT_TRUE(pool.UnUse(pos).has_value());
+	// UnUse reclaims right away if no reader is active
+	EXPECT_EQ(pool.RetiredCount(), 0u);
+	EXPECT_EQ(pool.ObjectsInUse(), 4u);
+	EXPECT_TRUE(pool.Use(2).has_value());
+}
+
+TEST(ConcurrentObjectPool, GuardReadsSnapshot)
+{
+	CConcurrentObjectPool<CEntity> pool(130);
+	for (const size_t pos : {0uz, 64uz, 129uz})
+	{
+		auto result = pool.Use(pos);
+		ASSERT_TRUE(result.has_value());
+		result.value()->id = static_cast<uint32_t>(pos);
+		ASSERT_TRUE(pool.Publish(pos).has_value());
+	}
+	ASSERT_TRUE(pool.Use(5).has_value());
+
+	const auto guard = pool.Read();
+	ASSERT_TRUE(pool.Publish(5).has_value());
+	ASSERT_TRUE(pool.UnUse(64).has_value());
+
+	// published after the snapshot: invisible, retired after it: still visible and intact
+	EXPECT_FALSE(guard.IsInUse(5));
+	EXPECT_EQ(guard.Get(5).error(), EPoolError::NOT_IN_USE);
+	const auto result = guard.Get(64);
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(result.value()->id, 64u);
+	std::vector<uint32_t> visited;
+	guard.ForEachActive([&visited](const CEntity& entity) { visited.push_back(entity.id); });
+	EXPECT_EQ(visited, (std::vector<uint32_t>{0, 64, 129}));
+	EXPECT_EQ(guard.Get(130).error(), EPoolError::OUT_OF_RANGE);
+}
+
+TEST(ConcurrentObjectPool, ReadReusesBuffer)
+{
+	CConcurrentObjectPool<CEntity> pool(130);
+	std::vector<uint64_t> buffer;
+	{
+		const auto guard = pool.Read(buffer);
+		EXPECT_FALSE(guard.IsInUse(0));
+	}
+	ASSERT_EQ(buffer.size(), 3u);
+	const uint64_t* pWords = buffer.data();
+
+	auto result = pool.Use(129);
+	ASSERT_TRUE(result.has_value());
+	result.value()->id = 129;
+	ASSERT_TRUE(pool.Publish(129).has_value());
+	const auto guard = pool.Read(buffer);
+	EXPECT_EQ(buffer.data(), pWords);
+	EXPECT_TRUE(guard.IsInUse(129));
+	std::vector<uint32_t> visited;
+	guard.ForEachActive([&visited](const CEntity& entity) { visited.push_back(entity.id); });
+	EXPECT_EQ(visited, (std::vector<uint32_t>{129}));
+}
+
+// Writers which never pause keep the seqlock busy, the reader has to get its snapshot anyway
+TEST(ConcurrentObjectPool, ReaderNotStarvedByWriters)
+{
+	constexpr size_t POOL_SIZE = 4096;
+	CConcurrentObjectPool<CEntity> pool(POOL_SIZE);
+	std::atomic<bool> bDone = false;
+
+	std::vector<std::thread> writers;
+	for (int writer = 0; writer < 2; ++writer)
+	{
+		writers.emplace_back([&]
+		{
+			while (!bDone.load())
+			{
+				size_t idx;
+				if (pool.UseNext(idx).has_value())
+				{
+					(void)pool.Publish(idx);
+					(void)pool.UnUse(idx);
+				}
+			}
+		});
+	}
+
+	std::vector<uint64_t> buffer;
+	size_t snapshots = 0;
+	for (; snapshots < 1000; ++snapshots)
+	{
+		const auto guard = pool.Read(buffer);
+		guard.ForEachActive([](const CEntity&) {});
+	}
+	bDone = true;
+	for (auto& writer : writers)
+		writer.join();
+
+	EXPECT_EQ(snapshots, 1000u);
+}
+
+// The writer publishes the slots in ascending order and retires them in ascending order,
+// so the published set is always a prefix or a suffix. Every snapshot must be one, too;
+// a scan of the live flags could see a slot published behind it without the one before.
+TEST(ConcurrentObjectPool, SnapshotIsLinearizable)
+{
+	constexpr size_t POOL_SIZE = 192;
+	CConcurrentObjectPool<CEntity> pool(POOL_SIZE);
+	std::atomic<bool> bDone = false;
+	std::atomic<size_t> torn = 0;
+	std::atomic<size_t> snapshots = 0;
+
+	std::vector<std::thread> readers;
+	for (int reader = 0; reader < 2; ++reader)
+	{
+		readers.emplace_back([&]
+		{
+			while (!bDone.load())
+			{
+				const auto guard = pool.Read();
+				size_t first = POOL_SIZE;
+				size_t count = 0;
+				for (size_t pos = 0; pos < POOL_SIZE; ++pos)
+				{
+					if (guard.IsInUse(pos))
+					{
+						first = std::min(first, pos);
+						++count;
+					}
+				}
+				const bool bInterval = count == 0 || [&]
+				{
+					for (size_t pos = first; pos < first + count; ++pos)
+					{
+						if (!guard.IsInUse(pos))
+							return false;
+					}
+					return first == 0 || first + count == POOL_SIZE;
+				}();
+				if (!bInterval)
+					torn.fetch_add(1);
+				snapshots.fetch_add(1);
+			}
+		});
+	}
+
+	for (int32_t round = 0; round < 50; ++round)
+	{
+		for (size_t pos = 0; pos < POOL_SIZE; ++pos)
+		{
+			// retired slots come back once the readers moved on
+			while (!pool.Use(pos).has_value())
+				(void)pool.Reclaim();
+			ASSERT_TRUE(pool.Publish(pos).has_value());
+		}
+		for (size_t pos = 0; pos < POOL_SIZE; ++pos)
+			ASSERT_TRUE(pool.UnUse(pos).has_value());
+	}
+	bDone = true;
+	for (auto& reader : readers)
+		reader.join();
+
+	EXPECT_GT(snapshots.load(), 0u);
+	EXPECT_EQ(torn.load(), 0u);
+}
+
+// Writers publish objects with a matching checksum and invalidate them on release,
+// readers must never observe an invalidated object.
+TEST(ConcurrentObjectPool, ReadersNeverSeeResetObjects)
+{
+	constexpr size_t POOL_SIZE = 256;
+	constexpr size_t ITERATIONS = 20000;
+	CConcurrentObjectPool<CEntity> pool(POOL_SIZE);
+	std::atomic<bool> bDone = false;
+	std::atomic<size_t> corrupted = 0;
+
+	std::vector<std::thread> readers;
+	for (int reader = 0; reader < 2; ++reader)
+	{
+		readers.emplace_back([&]
+		{
+			while (!bDone.load())
+			{
+				const auto guard = pool.Read();
+				guard.ForEachActive([&](const CEntity& entity)
+				{
+					if (entity.id == 0 || entity.checksum != ~entity.id)
+						corrupted.fetch_add(1);
+				});
+			}
+		});
+	}
+
+	std::mt19937 generator(42);
+	std::vector<size_t> live;
+	uint32_t nextId = 1;
+	for (size_t iteration = 0; iteration < ITERATIONS; ++iteration)
+	{
+		size_t idx;
+		if (auto result = pool.UseNext(idx); result.has_value())
+		{
+			(*result)->id = nextId;
+			(*result)->checksum = ~nextId;
+			++nextId;
+			ASSERT_TRUE(pool.Publish(idx).has_value());
+			live.push_back(idx);
+		}
+		if (live.size() > POOL_SIZE / 2)
+		{
+			const size_t victim = std::uniform_int_distribution<size_t>(0, live.size() - 1)(generator);
+			ASSERT_TRUE(pool.UnUse(live[victim]).has_value());
+			live[victim] = live.back();
+			live.pop_back();
+		}
+	}
+	bDone = true;
+	for (auto& reader : readers)
+		reader.join();
+
+	EXPECT_EQ(corrupted.load(), 0u);
+	EXPECT_EQ(pool.ObjectsInUse(), live.size());
+}
+}
@@ -0,0 +1,244 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <gtest/gtest.h>
+
+#include "../include/CMappedObjectPool.hpp"
+
+using namespace ObjectPool;
+
+namespace Tests::MappedObjectPool
+{
+struct CSession
+{
+	uint64_t userId = 0;
+	uint32_t requests = 0;
+};
+
+// Unique file in the temp directory, removed at the end of the test
+class MappedObjectPool : public testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		const auto* pInfo = testing::UnitTest::GetInstance()->current_test_info();
+		path = std::filesystem::temp_directory_path()
+			/ (std::string("object_pool_") + pInfo->name() + "_" + std::to_string(::getpid()) + ".pool");
+	}
+
+	void TearDown() override
+	{
+		std::filesystem::remove(path);
+	}
+
+	std::filesystem::path path;
+};
+
+TEST_F(MappedObjectPool, ReopenKeepsObjectsAndOccupancy)
+{
+	size_t first;
+	size_t second;
+	{
+		auto pool = CMappedObjectPool<CSession>::Create(path, 100);
+		ASSERT_TRUE(pool.has_value());
+		EXPECT_EQ(std::filesystem::file_size(path), CMappedObjectPool<CSession>::FileSize(100));
+		auto result = pool->UseNext(first);
+		ASSERT_TRUE(result.has_value());
+		result.value()->userId = 11;
+		result = pool->UseNext(second);
+		ASSERT_TRUE(result.has_value());
+		result.value()->userId = 22;
+		result = pool->Use(50);
+		ASSERT_TRUE(result.has_value());
+		result.value()->requests = 3;
+		ASSERT_TRUE(pool->UnUse(first).has_value());
+		EXPECT_TRUE(pool->Flush().has_value());
+	}
+
+	auto pool = CMappedObjectPool<CSession>::Open(path);
+	ASSERT_TRUE(pool.has_value());
+	EXPECT_EQ(pool->Size(), 100u);
+	EXPECT_EQ(pool->ObjectsInUse(), 2u);
+	EXPECT_FALSE(pool->IsInUse(first));
+	EXPECT_EQ((*pool)[first]->userId, 0u);
+	auto result = pool->Get(second);
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(result.value()->userId, 22u);
+	result = pool->Get(50);
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(result.value()->requests, 3u);
+	EXPECT_EQ(pool->Get(100).error(), EPoolError::OUT_OF_RANGE);
+	EXPECT_EQ(pool->Use(50).error(), EPoolError::ALREADY_IN_USE);
+
+	// the round-robin position is persisted as well
+	size_t third;
+	ASSERT_TRUE(pool->UseNext(third).has_value());
+	EXPECT_EQ(third, second + 1);
+
+	size_t visited = 0;
+	pool->ForEachActive([&visited](const CSession&) { ++visited; });
+	EXPECT_EQ(visited, 3u);
+}
+
+TEST_F(MappedObjectPool, UseNextReportsFull)
+{
+	auto pool = CMappedObjectPool<CSession>::Create(path, 2);
+	ASSERT_TRUE(pool.has_value());
+	size_t idx;
+	ASSERT_TRUE(pool->UseNext(idx).has_value());
+	ASSERT_TRUE(pool->UseNext(idx).has_value());
+	EXPECT_EQ(pool->UseNext(idx).error(), EPoolError::FULL);
+	EXPECT_EQ(pool->UnUse(5).error(), EPoolError::OUT_OF_RANGE);
+	ASSERT_TRUE(pool->UnUse(0).has_value());
+	EXPECT_EQ(pool->UnUse(0).error(), EPoolError::ALREADY_UNUSED);
+	ASSERT_TRUE(pool->UseNext(idx).has_value());
+	EXPECT_EQ(idx, 0u);
+}
+
+TEST_F(MappedObjectPool, OpenRejectsMismatchedFiles)
+{
+	EXPECT_EQ(CMappedObjectPool<CSession>::Open(path).error(), EMappedPoolError::OPEN_FAILED);
+
+	ASSERT_TRUE(CMappedObjectPool<CSession>::Create(path, 10).has_value());
+	EXPECT_EQ(CMappedObjectPool<uint32_t>::Open(path).error(), EMappedPoolError::TYPE_MISMATCH);
+
+	// truncated file
+	std::filesystem::resize_file(path, CMappedObjectPool<CSession>::FileSize(10) - 1);
+	EXPECT_EQ(CMappedObjectPool<CSession>::Open(path).error(), EMappedPoolError::INVALID_HEADER);
+
+	// not a pool at all
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file << std::string(256, 'x');
+	}
+	EXPECT_EQ(CMappedObjectPool<CSession>::Open(path).error(), EMappedPoolError::INVALID_HEADER);
+}
+
+TEST_F(MappedObjectPool, OpenRejectsOtherVersions)
+{
+	ASSERT_TRUE(CMappedObjectPool<CSession>::Create(path, 10).has_value());
+	{
+		std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+		file.seekp(offsetof(CMappedPoolHeader, version));
+		const uint32_t version = CMappedPoolHeader::VERSION + 1;
+		file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+	}
+	EXPECT_EQ(CMappedObjectPool<CSession>::Open(path).error(), EMappedPoolError::VERSION_MISMATCH);
+}
+
+TEST_F(MappedObjectPool, OpenRejectsCorruptFlags)
+{
+	{
+		auto pool = CMappedObjectPool<CSession>::Create(path, 10);
+		ASSERT_TRUE(pool.has_value());
+		ASSERT_TRUE(pool->Use(3).has_value());
+	}
+	const auto writeByte = [this](const size_t offset, const uint8_t value)
+	{
+		std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+		file.seekp(static_cast<std::streamoff>(offset));
+		file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	};
+	constexpr size_t FLAGS_OFFSET = Detail::CACHE_LINE_SIZE;
+	ASSERT_TRUE(CMappedObjectPool<CSession>::Open(path).has_value());
+
+	// flag value which is neither free nor used
+	writeByte(FLAGS_OFFSET + 5, 7);
+	EXPECT_EQ(CMappedObjectPool<CSession>::Open(path).error(), EMappedPoolError::INVALID_HEADER);
+
+	writeByte(FLAGS_OFFSET + 5, Detail::FLAG_FREE);
+	auto pool = CMappedObjectPool<CSession>::Open(path);
+	ASSERT_TRUE(pool.has_value());
+	EXPECT_EQ(pool->ObjectsInUse(), 1u);
+	EXPECT_TRUE(pool->IsInUse(3));
+}
+
+TEST_F(MappedObjectPool, OpenRebuildsStaleCounters)
+{
+	{
+		auto pool = CMappedObjectPool<CSession>::Create(path, 10);
+		ASSERT_TRUE(pool.has_value());
+		ASSERT_TRUE(pool->Use(3).has_value());
+		ASSERT_TRUE(pool->Use(4).has_value());
+	}
+	// as if the process died after storing a flag, but before the header
+	{
+		std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+		file.seekp(offsetof(CMappedPoolHeader, objectsInUse));
+		const uint64_t counters[] = {7, 42}; // objectsInUse, nextIdx
+		file.write(reinterpret_cast<const char*>(counters), sizeof(counters));
+	}
+
+	{
+		auto pool = CMappedObjectPool<CSession>::Open(path);
+		ASSERT_TRUE(pool.has_value());
+		EXPECT_EQ(pool->ObjectsInUse(), 2u);
+		size_t idx;
+		ASSERT_TRUE(pool->UseNext(idx).has_value());
+		EXPECT_EQ(idx, 0u);
+		ASSERT_TRUE(pool->UnUse(3).has_value());
+		EXPECT_EQ(pool->ObjectsInUse(), 2u);
+	}
+	auto pool = CMappedObjectPool<CSession>::Open(path);
+	ASSERT_TRUE(pool.has_value());
+	EXPECT_EQ(pool->ObjectsInUse(), 2u);
+}
+
+TEST_F(MappedObjectPool, FileIsLockedWhileOpen)
+{
+	auto pool = CMappedObjectPool<CSession>::Create(path, 10);
+	ASSERT_TRUE(pool.has_value());
+	auto result = pool->Use(1);
+	ASSERT_TRUE(result.has_value());
+	result.value()->userId = 5;
+
+	// neither a second pool nor a re-create may touch the file while the first one maps it
+	EXPECT_EQ(CMappedObjectPool<CSession>::Open(path).error(), EMappedPoolError::LOCKED);
+	EXPECT_EQ(CMappedObjectPool<CSession>::Create(path, 20).error(), EMappedPoolError::LOCKED);
+	EXPECT_EQ(std::filesystem::file_size(path), CMappedObjectPool<CSession>::FileSize(10));
+
+	// the lock moves with the pool and is released by its destruction
+	auto moved = std::move(*pool);
+	EXPECT_EQ(CMappedObjectPool<CSession>::Open(path).error(), EMappedPoolError::LOCKED);
+	{
+		auto sink = std::move(moved);
+	}
+	auto reopened = CMappedObjectPool<CSession>::Open(path);
+	ASSERT_TRUE(reopened.has_value());
+	const auto resultGet = reopened->Get(1);
+	ASSERT_TRUE(resultGet.has_value());
+	EXPECT_EQ(resultGet.value()->userId, 5u);
+}
+
+TEST_F(MappedObjectPool, MovedFromPoolIsEmpty)
+{
+	auto pool = CMappedObjectPool<CSession>::Create(path, 10);
+	ASSERT_TRUE(pool.has_value());
+	ASSERT_TRUE(pool->Use(2).has_value());
+
+	auto target = std::move(*pool);
+	EXPECT_EQ(target.Size(), 10u);
+	EXPECT_EQ(target.ObjectsInUse(), 1u);
+	EXPECT_EQ(pool->Size(), 0u);
+	EXPECT_EQ(pool->ObjectsInUse(), 0u);
+	EXPECT_FALSE(pool->IsInUse(0));
+	EXPECT_EQ(pool->Use(0).error(), EPoolError::OUT_OF_RANGE);
+	EXPECT_EQ(pool->Get(2).error(), EPoolError::OUT_OF_RANGE);
+	EXPECT_EQ(pool->UnUse(2).error(), EPoolError::OUT_OF_RANGE);
+	size_t idx;
+	EXPECT_EQ(pool->UseNext(idx).error(), EPoolError::FULL);
+	size_t visited = 0;
+	pool->ForEachActive([&visited](const CSession&) { ++visited; });
+	EXPECT_EQ(visited, 0u);
+	EXPECT_TRUE(pool->Flush().has_value());
+
+	// assigning back swaps the mappings
+	*pool = std::move(target);
+	EXPECT_EQ(pool->Size(), 10u);
+	EXPECT_TRUE(pool->IsInUse(2));
+	EXPECT_EQ(target.Size(), 0u);
+	EXPECT_EQ(target.ObjectsInUse(), 0u);
+}
+}
@@ -1,6 +1,14 @@
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <execution>
+#include <random>
 #include <ranges>
+#include <span>
+#include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include "../include/CObjectPool.hpp"
@@ -51,6 +59,30 @@ TEST(ObjectPool, Constructor_WithArgs)
 	}
 }
 
+TEST(ObjectPool, Destructor_DestroysAllObjects)
+{
+	struct CTracked
+	{
+		int32_t* pDestroyed = nullptr;
+		~CTracked()
+		{
+			if (pDestroyed != nullptr)
+				++*pDestroyed;
+		}
+	};
+
+	int32_t destroyed = 0;
+	{
+		auto pool = CObjectPool<CTracked>(4, CTracked{&destroyed});
+		destroyed = 0; // the temporary argument
+		auto result = pool.Use(1);
+		ASSERT_TRUE(result);
+		EXPECT_EQ(destroyed, 0);
+	}
+	// used and unused slots alike
+	EXPECT_EQ(destroyed, 4);
+}
+
 TEST(ObjectPool, Overflow)
 {
 	auto colorPool = CObjectPool<CColor>(1);
@@ -1064,4 +1096,1520 @@ TEST(ObjectPool, Iterator_Ranges_Views_Filter)
 		EXPECT_EQ(colorPool[poolIdx]->b, 100);
 	}
 }
+
+// Statistics policy with exactly one word of state, to measure what a policy adds to the pool
+struct CWordStats
+{
+	uint64_t acquires = 0;
+
+	void OnAcquire(size_t) noexcept { ++acquires; }
+	void OnRelease() noexcept {}
+	void OnScan(size_t) noexcept {}
+	void OnFull() noexcept {}
+};
+
+TEST(ObjectPool, Stats_DisabledByDefault)
+{
+	// The default statistics policy must not add any state to the pool: a policy with one
+	// word grows the pool by exactly that word, so the default one takes no space at all
+	EXPECT_TRUE(std::is_empty_v<CNoPoolStats>);
+	EXPECT_EQ(sizeof(CObjectPool<CColor, CWordStats>), sizeof(CObjectPool<CColor>) + sizeof(uint64_t));
+}
+
+TEST(ObjectPool, Stats_Counters)
+{
+	auto colorPool = CObjectPool<CColor, CPoolStats>(3);
+	size_t idx;
+
+	auto result = colorPool.UseNext(idx); // 0
+	ASSERT_TRUE(result.has_value());
+	result = colorPool.Use(2);
+	ASSERT_TRUE(result.has_value());
+	result = colorPool.UseNextReplace(idx); // 1
+	ASSERT_TRUE(result.has_value());
+
+	// Pool is full now
+	result = colorPool.UseNext(idx);
+	ASSERT_FALSE(result.has_value());
+	result = colorPool.UseNextReplace(idx, 1, 2, 3);
+	ASSERT_FALSE(result.has_value());
+
+	auto resultUnuse = colorPool.UnUse(0);
+	ASSERT_TRUE(resultUnuse.has_value());
+	// Failed UnUse must not be counted
+	resultUnuse = colorPool.UnUse(0);
+	ASSERT_FALSE(resultUnuse.has_value());
+
+	const auto& stats = colorPool.Stats();
+	EXPECT_EQ(stats.Acquires(), 3);
+	EXPECT_EQ(stats.Releases(), 1);
+	EXPECT_EQ(stats.FullFailures(), 2);
+	EXPECT_EQ(stats.PeakObjectsInUse(), 3);
+	EXPECT_EQ(colorPool.ObjectsInUse(), 2);
+
+	colorPool.Stats().Reset();
+	EXPECT_EQ(colorPool.Stats().Acquires(), 0);
+	EXPECT_EQ(colorPool.Stats().PeakObjectsInUse(), 0);
+	EXPECT_EQ(colorPool.Stats().ScanHistogram().Count(), 0);
+}
+
+TEST(ObjectPool, Stats_ScanHistogram)
+{
+	auto colorPool = CObjectPool<CColor, CPoolStats>(8);
+	size_t idx;
+
+	// Occupy all slots, each UseNext finds its slot immediately
+	for (size_t poolIdx = 0; poolIdx < 8; ++poolIdx)
+	{
+		auto result = colorPool.UseNext(idx);
+		ASSERT_TRUE(result.has_value());
+	}
+	const auto& histogram = colorPool.Stats().ScanHistogram();
+	EXPECT_EQ(histogram.Count(), 8);
+	EXPECT_EQ(histogram.BucketCount(1), 8); // scanned exactly 1 slot
+
+	// Free 2 - the next search starts at 7 and has to wrap around
+	auto resultUnuse = colorPool.UnUse(2);
+	ASSERT_TRUE(resultUnuse.has_value());
+	auto result = colorPool.UseNext(idx);
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(idx, 2);
+	EXPECT_EQ(histogram.Count(), 9);
+	EXPECT_EQ(histogram.Percentile(1.0), 7); // scanned 7, 0, 1, 2 -> bucket [4, 7]
+
+	// A failed search scans the whole pool
+	result = colorPool.UseNext(idx);
+	ASSERT_FALSE(result.has_value());
+	EXPECT_EQ(histogram.BucketCount(4), 1); // 8 -> bucket [8, 15]
+	EXPECT_EQ(histogram.Percentile(0.5), 1);
+}
+
+TEST(ObjectPool, LogHistogram_Buckets)
+{
+	CLogHistogram histogram;
+	EXPECT_EQ(histogram.Percentile(0.5), 0); // empty
+
+	histogram.Record(0);
+	histogram.Record(1);
+	histogram.Record(5);
+	histogram.Record(1000);
+	EXPECT_EQ(histogram.Count(), 4);
+	EXPECT_EQ(histogram.BucketCount(0), 1);
+	EXPECT_EQ(histogram.BucketCount(1), 1);
+	EXPECT_EQ(histogram.BucketCount(3), 1); // [4, 7]
+	EXPECT_EQ(histogram.BucketCount(10), 1); // [512, 1023]
+
+	EXPECT_EQ(CLogHistogram::BucketLowerBound(3), 4);
+	EXPECT_EQ(CLogHistogram::BucketUpperBound(3), 7);
+	EXPECT_EQ(CLogHistogram::BucketUpperBound(64), UINT64_MAX);
+
+	EXPECT_EQ(histogram.Percentile(0.0), 0);
+	EXPECT_EQ(histogram.Percentile(1.0), 1023);
+}
+
+// Observer which records every event as a readable string
+struct CRecordingObserver
+{
+	std::vector<std::string> events;
+
+	void OnUse(const size_t idx) { events.push_back("use " + std::to_string(idx)); }
+	void OnUnUse(const size_t idx) { events.push_back("unuse " + std::to_string(idx)); }
+	void OnFull() { events.emplace_back("full"); }
+	void OnReplace(const size_t idx) { events.push_back("replace " + std::to_string(idx)); }
+};
+
+// Observer policy with exactly one word of state, see `CWordStats`
+struct CWordObserver
+{
+	uint64_t events = 0;
+
+	void OnUse(size_t) noexcept { ++events; }
+	void OnUnUse(size_t) noexcept {}
+	void OnFull() noexcept {}
+	void OnReplace(size_t) noexcept {}
+};
+
+TEST(ObjectPool, Observer_DisabledByDefault)
+{
+	EXPECT_TRUE(std::is_empty_v<CNoPoolObserver>);
+	EXPECT_EQ(sizeof(CObjectPool<CColor, CNoPoolStats, CWordObserver>), sizeof(CObjectPool<CColor>) + sizeof(uint64_t));
+	// both defaults together take no space either
+	EXPECT_EQ(sizeof(CObjectPool<CColor, CWordStats, CWordObserver>), sizeof(CObjectPool<CColor>) + 2 * sizeof(uint64_t));
+}
+
+TEST(ObjectPool, Observer_Events)
+{
+	auto colorPool = CObjectPool<CColor, CNoPoolStats, CRecordingObserver>(2);
+	size_t idx;
+
+	auto result = colorPool.UseNext(idx); // 0
+	ASSERT_TRUE(result.has_value());
+	result = colorPool.UseNextReplace(idx, 1, 2, 3); // 1
+	ASSERT_TRUE(result.has_value());
+	result = colorPool.UseNext(idx);
+	ASSERT_FALSE(result.has_value());
+	auto resultUnuse = colorPool.UnUse(0);
+	ASSERT_TRUE(resultUnuse.has_value());
+	result = colorPool.Use(0);
+	ASSERT_TRUE(result.has_value());
+
+	// Failed operations must not be reported (except FULL)
+	result = colorPool.Use(0);
+	ASSERT_FALSE(result.has_value());
+	resultUnuse = colorPool.UnUse(5);
+	ASSERT_FALSE(resultUnuse.has_value());
+
+	const std::vector<std::string> expected = {
+		"use 0",
+		"replace 1", "use 1",
+		"full",
+		"replace 0", "unuse 0",
+		"use 0"
+	};
+	EXPECT_EQ(colorPool.Observer().events, expected);
+}
+
+// Clock which only advances when told to, so hold times are deterministic
+struct CManualClock
+{
+	using duration = std::chrono::nanoseconds;
+	using rep = duration::rep;
+	using period = duration::period;
+	using time_point = std::chrono::time_point<CManualClock>;
+	static constexpr bool is_steady = true;
+
+	static inline time_point current{};
+
+	static time_point now() noexcept { return current; }
+	static void Advance(const duration elapsed) noexcept { current += elapsed; }
+};
+
+TEST(ObjectPool, HoldTime_Histogram)
+{
+	auto colorPool = CObjectPool<CColor, CNoPoolStats, CHoldTimeObserver<CManualClock>>(4);
+	size_t idx0, idx1;
+
+	// Hold slot 0 for 100ns and slot 1 for 10000ns
+	auto result = colorPool.UseNext(idx0);
+	ASSERT_TRUE(result.has_value());
+	result = colorPool.UseNext(idx1);
+	ASSERT_TRUE(result.has_value());
+	CManualClock::Advance(std::chrono::nanoseconds(100));
+	auto resultUnuse = colorPool.UnUse(idx0);
+	ASSERT_TRUE(resultUnuse.has_value());
+	CManualClock::Advance(std::chrono::nanoseconds(9900));
+	resultUnuse = colorPool.UnUse(idx1);
+	ASSERT_TRUE(resultUnuse.has_value());
+
+	const auto& observer = colorPool.Observer();
+	EXPECT_EQ(observer.Histogram().Count(), 2);
+	EXPECT_EQ(observer.Histogram().BucketCount(7), 1); // 100 -> [64, 127]
+	EXPECT_EQ(observer.Histogram().BucketCount(14), 1); // 10000 -> [8192, 16383]
+
+	const auto summary = observer.Summary();
+	EXPECT_EQ(summary.count, 2);
+	EXPECT_EQ(summary.p50, std::chrono::nanoseconds(127));
+	EXPECT_EQ(summary.p99, std::chrono::nanoseconds(10000)); // capped by the exact maximum
+	EXPECT_EQ(summary.max, std::chrono::nanoseconds(10000));
+
+	// Slots still in use are not part of the histogram
+	result = colorPool.Use(3);
+	ASSERT_TRUE(result.has_value());
+	CManualClock::Advance(std::chrono::nanoseconds(5));
+	EXPECT_EQ(colorPool.Observer().Summary().count, 2);
+
+	colorPool.Observer().Reset();
+	resultUnuse = colorPool.UnUse(3);
+	ASSERT_TRUE(resultUnuse.has_value());
+	EXPECT_EQ(colorPool.Observer().Summary().max, std::chrono::nanoseconds(5));
+}
+
+TEST(ObjectPool, ForEachActive_Sequential)
+{
+	auto colorPool = CObjectPool<CColor>(5);
+
+	// Use positions 0, 2, 3
+	auto result = colorPool.Use(0);
+	ASSERT_TRUE(result.has_value());
+	result = colorPool.Use(2);
+	ASSERT_TRUE(result.has_value());
+	result = colorPool.Use(3);
+	ASSERT_TRUE(result.has_value());
+
+	size_t visited = 0;
+	colorPool.ForEachActive([&visited](CColor& color)
+	{
+		color.r = 1;
+		++visited;
+	});
+
+	EXPECT_EQ(visited, 3);
+	EXPECT_EQ(colorPool[0]->r, 1);
+	EXPECT_EQ(colorPool[1]->r, 255); // unused, not visited
+	EXPECT_EQ(colorPool[2]->r, 1);
+	EXPECT_EQ(colorPool[3]->r, 1);
+	EXPECT_EQ(colorPool[4]->r, 255); // unused, not visited
+}
+
+TEST(ObjectPool, ForEachActive_Parallel)
+{
+	// Several chunks with a partially filled tail
+	constexpr size_t poolSize = 10'000;
+	auto colorPool = CObjectPool<CColor>(poolSize);
+	for (size_t poolIdx = 0; poolIdx < poolSize; ++poolIdx)
+	{
+		if (poolIdx % 3 == 0)
+			continue;
+		auto result = colorPool.Use(poolIdx);
+		ASSERT_TRUE(result.has_value());
+	}
+
+	std::atomic<size_t> visited = 0;
+	colorPool.ForEachActive(std::execution::par, [&visited](CColor& color)
+	{
+		color.g = 0;
+		visited.fetch_add(1, std::memory_order_relaxed);
+	});
+
+	EXPECT_EQ(visited.load(), colorPool.ObjectsInUse());
+	for (size_t poolIdx = 0; poolIdx < poolSize; ++poolIdx)
+	{
+		EXPECT_EQ(colorPool[poolIdx]->g, poolIdx % 3 == 0 ? 255 : 0);
+	}
+
+	// Empty pools have no chunk to process
+	auto emptyPool = CObjectPool<CColor>(0);
+	emptyPool.ForEachActive(std::execution::par_unseq, [](CColor&)
+	{
+		FAIL();
+	});
+}
+
+TEST(ObjectPool, ForEachActive_ChunksOnCacheLines)
+{
+	// the owned storage starts on a cache line, so the chunks do too
+	constexpr size_t poolSize = 5'000;
+	auto pool = CObjectPool<uint64_t>(poolSize);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(pool[0]) % 64, 0u);
+
+	// a buffer starting one slot past a line gets a short leading chunk, every slot is visited once
+	alignas(64) static std::array<std::byte, 64 + CObjectPool<uint64_t>::BufferSize(poolSize)> buffer{};
+	const std::span<std::byte> memory(buffer);
+	auto shifted = CObjectPool<uint64_t>(memory.subspan(sizeof(uint64_t)), 0u);
+	ASSERT_GE(shifted.Size(), poolSize);
+	for (size_t poolIdx = 0; poolIdx < shifted.Size(); ++poolIdx)
+	{
+		auto result = shifted.Use(poolIdx);
+		ASSERT_TRUE(result.has_value());
+	}
+
+	shifted.ForEachActive(std::execution::par, [](uint64_t& value)
+	{
+		++value;
+	});
+	for (size_t poolIdx = 0; poolIdx < shifted.Size(); ++poolIdx)
+	{
+		EXPECT_EQ(*shifted[poolIdx], 1u);
+	}
+}
+
+TEST(ObjectPool, Runs_Contiguous)
+{
+	auto colorPool = CObjectPool<CColor>(10);
+
+	// Use positions 0, 1, 4, 5, 6, 9
+	for (const size_t pos : {0, 1, 4, 5, 6, 9})
+	{
+		auto result = colorPool.Use(pos);
+		ASSERT_TRUE(result.has_value());
+		colorPool[pos]->r = pos;
+	}
+
+	std::vector<std::pair<uint8_t, size_t>> runs; // first r value & length
+	for (const std::span<CColor> run : colorPool.Runs())
+	{
+		runs.emplace_back(run.front().r, run.size());
+	}
+
+	const std::vector<std::pair<uint8_t, size_t>> expected = {{0, 2}, {4, 3}, {9, 1}};
+	EXPECT_EQ(runs, expected);
+
+	// The spans are views into the pool
+	for (const std::span<CColor> run : colorPool.Runs())
+	{
+		for (CColor& color : run)
+			color.b = 7;
+	}
+	EXPECT_EQ(colorPool[5]->b, 7);
+	EXPECT_EQ(colorPool[3]->b, 255); // unused
+}
+
+TEST(ObjectPool, Runs_EmptyAndFull)
+{
+	auto colorPool = CObjectPool<CColor>(4);
+	EXPECT_EQ(colorPool.Runs().begin(), colorPool.Runs().end());
+
+	size_t idx;
+	for (size_t poolIdx = 0; poolIdx < 4; ++poolIdx)
+	{
+		auto result = colorPool.UseNext(idx);
+		ASSERT_TRUE(result.has_value());
+	}
+
+	auto it = colorPool.Runs().begin();
+	EXPECT_EQ(it->size(), 4);
+	EXPECT_EQ(it->data(), colorPool[0]);
+	++it;
+	EXPECT_EQ(it, colorPool.Runs().end());
+
+	// Works with the ranges library
+	static_assert(std::ranges::forward_range<CObjectPool<CColor>::CRunView>);
+	static_assert(std::same_as<std::iterator_traits<CObjectPool<CColor>::CRunIterator>::iterator_category,
+	                           std::input_iterator_tag>);
+	EXPECT_EQ(std::ranges::distance(colorPool.Runs()), 1);
+}
+
+TEST(ObjectPool, FindFlag_MatchesNaiveScan)
+{
+	// Cover the AVX2 / SSE2 / SWAR widths, their tails and unaligned starts
+	std::mt19937 generator(7);
+	for (const size_t flagCount : {0, 1, 7, 8, 15, 16, 31, 32, 33, 64, 100, 257})
+	{
+		for (const int density : {0, 1, 50, 99, 100})
+		{
+			std::bernoulli_distribution bUsed(density / 100.0);
+			std::vector<uint8_t> flags(flagCount);
+			for (auto& flag : flags)
+				flag = bUsed(generator) ? Detail::FLAG_USED : Detail::FLAG_FREE;
+
+			for (size_t from = 0; from <= std::min<size_t>(flagCount, 9); ++from)
+			{
+				for (const uint8_t value : {Detail::FLAG_FREE, Detail::FLAG_USED})
+				{
+					const auto naive = std::find(flags.begin() + from, flags.end(), value) - flags.begin();
+					EXPECT_EQ(Detail::FindFlag(flags.data(), from, flagCount, value), naive);
+					EXPECT_EQ(Detail::FindFlagScalar(flags.data(), from, flagCount, value), naive);
+				}
+			}
+		}
+	}
+}
+
+TEST(ObjectPool, UseNext_LargeSparsePool)
+{
+	// Exercise the vectorized search with the only free slot far behind `nextIdx`
+	constexpr size_t poolSize = 1000;
+	auto colorPool = CObjectPool<CColor>(poolSize);
+	size_t idx;
+	for (size_t poolIdx = 0; poolIdx < poolSize; ++poolIdx)
+	{
+		auto result = colorPool.UseNext(idx);
+		ASSERT_TRUE(result.has_value());
+		EXPECT_EQ(idx, poolIdx);
+	}
+
+	auto resultUnuse = colorPool.UnUse(437);
+	ASSERT_TRUE(resultUnuse.has_value());
+	auto result = colorPool.UseNext(idx);
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(idx, 437);
+
+	result = colorPool.UseNext(idx);
+	ASSERT_FALSE(result.has_value());
+	EXPECT_EQ(result.error(), EPoolError::FULL);
+
+	// Iteration skips long gaps
+	for (size_t poolIdx = 0; poolIdx < poolSize - 1; ++poolIdx)
+	{
+		resultUnuse = colorPool.UnUse(poolIdx);
+		ASSERT_TRUE(resultUnuse.has_value());
+	}
+	auto it = colorPool.begin();
+	EXPECT_EQ(&*it, colorPool[poolSize - 1]);
+	EXPECT_EQ(++it, colorPool.end());
+}
+
+TEST(ObjectPool, FindFlagWrapped_MatchesModuloScan)
+{
+	std::mt19937 generator(11);
+	for (const size_t flagCount : {0, 1, 2, 17, 64, 129})
+	{
+		for (const int density : {0, 50, 97, 100})
+		{
+			std::bernoulli_distribution bUsed(density / 100.0);
+			std::vector<uint8_t> flags(flagCount);
+			for (auto& flag : flags)
+				flag = bUsed(generator) ? Detail::FLAG_USED : Detail::FLAG_FREE;
+
+			for (size_t start = 0; start < flagCount; ++start)
+			{
+				// Reference: the former modulo loop
+				size_t expected = flagCount;
+				for (size_t pos = start, idx = 0; idx < flagCount; ++pos, pos %= flagCount, ++idx)
+				{
+					if (flags[pos] == Detail::FLAG_FREE)
+					{
+						expected = pos;
+						break;
+					}
+				}
+				EXPECT_EQ(Detail::FindFlagWrapped(flags.data(), flagCount, start, Detail::FLAG_FREE), expected);
+			}
+		}
+	}
+	EXPECT_EQ(Detail::FindFlagWrapped(nullptr, 0, 0, Detail::FLAG_FREE), 0);
+}
+
+TEST(ObjectPool, UseNext_WrapsAroundAfterUse)
+{
+	auto colorPool = CObjectPool<CColor>(6);
+	size_t idx;
+
+	// Use 3 directly, then fill the rest with UseNext: 0, 1, 2, 4, 5
+	auto result = colorPool.Use(3);
+	ASSERT_TRUE(result.has_value());
+	for (const size_t expected : {0, 1, 2, 4, 5})
+	{
+		result = colorPool.UseNext(idx);
+		ASSERT_TRUE(result.has_value());
+		EXPECT_EQ(idx, expected);
+	}
+
+	// Free 1 and 4, the search continues behind the last found slot (5) and wraps to 1
+	auto resultUnuse = colorPool.UnUse(1);
+	ASSERT_TRUE(resultUnuse.has_value());
+	resultUnuse = colorPool.UnUse(4);
+	ASSERT_TRUE(resultUnuse.has_value());
+	result = colorPool.UseNextReplace(idx);
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(idx, 1);
+	result = colorPool.UseNextReplace(idx, 1, 2, 3);
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(idx, 4);
+	EXPECT_EQ(colorPool.ObjectsInUse(), 6);
+}
+
+// Read-only consumer which only gets a const reference to the pool
+uint32_t SumRed(const CObjectPool<CColor>& pool)
+{
+	uint32_t sum = 0;
+	for (const CColor& color : pool)
+		sum += color.r;
+	return sum;
+}
+
+TEST(ObjectPool, ConstIterator_RangeBasedForLoop)
+{
+	auto colorPool = CObjectPool<CColor>(5);
+
+	// Use positions 1, 3, 4
+	for (const size_t pos : {1, 3, 4})
+	{
+		auto result = colorPool.Use(pos);
+		ASSERT_TRUE(result.has_value());
+		colorPool[pos]->r = pos;
+	}
+
+	EXPECT_EQ(SumRed(colorPool), 8);
+
+	const auto& constPool = colorPool;
+	static_assert(std::is_same_v<decltype(constPool.begin()), CObjectPool<CColor>::CConstIterator>);
+	static_assert(std::is_same_v<decltype(*constPool.begin()), const CColor&>);
+	static_assert(std::is_same_v<decltype(constPool[0]), const CColor*>);
+	static_assert(std::ranges::forward_range<const CObjectPool<CColor>>);
+
+	const auto count = std::ranges::count_if(constPool, [](const CColor& color)
+	{
+		return color.r >= 3;
+	});
+	EXPECT_EQ(count, 2);
+}
+
+TEST(ObjectPool, ConstIterator_CBeginCEnd)
+{
+	auto colorPool = CObjectPool<CColor>(3);
+	EXPECT_EQ(colorPool.cbegin(), colorPool.cend());
+
+	size_t idx;
+	auto result = colorPool.UseNext(idx);
+	ASSERT_TRUE(result.has_value());
+	colorPool[0]->g = 42;
+
+	auto it = colorPool.cbegin();
+	static_assert(std::is_same_v<decltype(it), CObjectPool<CColor>::CConstIterator>);
+	EXPECT_EQ(it->g, 42);
+	EXPECT_EQ(++it, colorPool.cend());
+
+	// Mutable iterators convert to const iterators
+	const CObjectPool<CColor>::CConstIterator converted = colorPool.begin();
+	EXPECT_EQ(converted, colorPool.cbegin());
+	EXPECT_EQ(converted->g, 42);
+
+	// Default constructed const iterators compare equal
+	EXPECT_EQ(CObjectPool<CColor>::CConstIterator(), CObjectPool<CColor>::CConstIterator());
+}
+
+TEST(ObjectPool, FindFlagBackward_MatchesNaiveScan)
+{
+	std::mt19937 generator(42);
+	std::bernoulli_distribution isUsed(0.05);
+	std::vector<uint8_t> flags(333);
+	for (auto& flag : flags)
+		flag = isUsed(generator) ? Detail::FLAG_USED : Detail::FLAG_FREE;
+
+	for (size_t from = 0; from < flags.size(); from += 7)
+	{
+		for (size_t to = from; to <= flags.size(); to += 5)
+		{
+			size_t expected = to;
+			for (size_t pos = to; pos > from; --pos)
+			{
+				if (flags[pos - 1] == Detail::FLAG_USED)
+				{
+					expected = pos - 1;
+					break;
+				}
+			}
+			EXPECT_EQ(Detail::FindFlagBackward(flags.data(), from, to, Detail::FLAG_USED), expected);
+			EXPECT_EQ(Detail::FindFlagBackwardScalar(flags.data(), from, to, Detail::FLAG_USED), expected);
+		}
+	}
+}
+
+TEST(ObjectPool, Iterator_Bidirectional)
+{
+	static_assert(std::bidirectional_iterator<CObjectPool<CColor>::CIterator>);
+	static_assert(std::bidirectional_iterator<CObjectPool<CColor>::CConstIterator>);
+
+	auto pool = CObjectPool<CColor>(100);
+	for (const size_t idx : {3uz, 40uz, 41uz, 97uz})
+	{
+		auto result = pool.Use(idx);
+		ASSERT_TRUE(result.has_value());
+		result.value()->r = static_cast<uint8_t>(idx);
+	}
+
+	std::vector<uint8_t> reversed;
+	for (const CColor& object : pool | std::views::reverse)
+		reversed.push_back(object.r);
+	EXPECT_EQ(reversed, (std::vector<uint8_t>{97, 41, 40, 3}));
+
+	// reorder the live objects in place
+	std::ranges::reverse(pool);
+	auto result = pool.Get(3);
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(result.value()->r, 97);
+	result = pool.Get(97);
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(result.value()->r, 3);
+
+	const auto isEven = [](const CColor& object) { return object.r % 2 == 0; };
+	const auto tail = std::ranges::partition(pool, isEven);
+	EXPECT_TRUE(std::all_of(pool.begin(), tail.begin(), isEven));
+	EXPECT_TRUE(std::none_of(tail.begin(), tail.end(), isEven));
+}
+
+TEST(ObjectPool, Slots_RandomAccess)
+{
+	static_assert(std::random_access_iterator<CObjectPool<CColor>::CSlotIterator>);
+	static_assert(std::random_access_iterator<CObjectPool<CColor>::CConstSlotIterator>);
+	static_assert(std::ranges::random_access_range<CObjectPool<CColor>::CSlotView>);
+	// the proxy reference is a value, legacy algorithms must not rely on more than input iterators
+	static_assert(std::same_as<std::iterator_traits<CObjectPool<CColor>::CSlotIterator>::iterator_category,
+	                           std::input_iterator_tag>);
+
+	auto pool = CObjectPool<CColor>(10000);
+	for (size_t idx = 0; idx < pool.Size(); idx += 3)
+	{
+		auto result = pool.Use(idx);
+		ASSERT_TRUE(result.has_value());
+	}
+
+	auto slots = pool.Slots();
+	ASSERT_EQ(slots.size(), pool.Size());
+	EXPECT_TRUE(slots[9].bInUse);
+	EXPECT_FALSE(slots[10].bInUse);
+	EXPECT_EQ(slots[9].pObject, pool[9]);
+	EXPECT_EQ((slots.end() - slots.begin()), static_cast<std::ptrdiff_t>(pool.Size()));
+	EXPECT_EQ((*(slots.begin() + 12)).idx, 12u);
+
+	std::ranges::for_each(slots, [](const auto slot)
+	{
+		if (slot.bInUse)
+			slot.pObject->g = static_cast<uint8_t>(slot.idx % 3);
+	});
+	for (const CColor& object : pool)
+		EXPECT_EQ(object.g, 0u);
+
+	const auto& constPool = pool;
+	const auto used = std::ranges::count_if(constPool.Slots(), &CObjectPool<CColor>::CConstSlot::bInUse);
+	EXPECT_EQ(static_cast<size_t>(used), pool.ObjectsInUse());
+}
+
+TEST(ObjectPool, Move_Constructor)
+{
+	static_assert(std::is_nothrow_move_constructible_v<CObjectPool<CColor>>);
+	static_assert(std::is_nothrow_move_assignable_v<CObjectPool<CColor>>);
+	static_assert(std::is_nothrow_swappable_v<CObjectPool<CColor>>);
+
+	auto source = CObjectPool<CColor, CPoolStats>(4);
+	size_t idx;
+	auto result = source.UseNext(idx);
+	ASSERT_TRUE(result.has_value());
+	CColor* pColor = result.value();
+	pColor->r = 7;
+
+	auto target = CObjectPool<CColor, CPoolStats>(std::move(source));
+	EXPECT_EQ(target.Size(), 4u);
+	EXPECT_EQ(target.ObjectsInUse(), 1u);
+	EXPECT_EQ(target.Stats().Acquires(), 1u);
+	// the objects stay where they are
+	result = target.Get(idx);
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(result.value(), pColor);
+
+	// the moved-from pool is empty, but usable
+	EXPECT_EQ(source.Size(), 0u);
+	EXPECT_EQ(source.ObjectsInUse(), 0u);
+	EXPECT_EQ(source.begin(), source.end());
+	EXPECT_EQ(source.UseNext(idx).error(), EPoolError::FULL);
+	EXPECT_EQ(source.Get(0).error(), EPoolError::OUT_OF_RANGE);
+}
+
+TEST(ObjectPool, Move_AssignmentAndSwap)
+{
+	auto front = CObjectPool<CColor>(2);
+	auto back = CObjectPool<CColor>(3);
+	auto result = front.Use(1);
+	ASSERT_TRUE(result.has_value());
+	result = back.Use(0);
+	ASSERT_TRUE(result.has_value());
+	result = back.Use(2);
+	ASSERT_TRUE(result.has_value());
+
+	swap(front, back);
+	EXPECT_EQ(front.Size(), 3u);
+	EXPECT_EQ(front.ObjectsInUse(), 2u);
+	EXPECT_TRUE(front.IsInUse(2));
+	EXPECT_EQ(back.Size(), 2u);
+	EXPECT_TRUE(back.IsInUse(1));
+
+	back = std::move(front);
+	EXPECT_EQ(back.Size(), 3u);
+	EXPECT_TRUE(back.IsInUse(0));
+	EXPECT_EQ(front.Size(), 0u);
+
+	// pools can be stored by value now
+	std::vector<CObjectPool<CColor>> levels;
+	levels.emplace_back(8);
+	levels.push_back(std::move(back));
+	levels.emplace_back(16);
+	EXPECT_EQ(levels[1].Size(), 3u);
+	EXPECT_EQ(levels[1].ObjectsInUse(), 2u);
+}
+
+TEST(ObjectPool, Compact_PacksActiveObjects)
+{
+	auto pool = CObjectPool<std::string>(8);
+	for (const size_t idx : {1uz, 4uz, 6uz, 7uz})
+	{
+		auto result = pool.Use(idx);
+		ASSERT_TRUE(result.has_value());
+		*result.value() = "object " + std::to_string(idx);
+	}
+
+	std::vector<std::pair<size_t, size_t>> moves;
+	const size_t moved = pool.Compact([&moves](const size_t old_pos, const size_t new_pos)
+	{
+		moves.emplace_back(old_pos, new_pos);
+	});
+	EXPECT_EQ(moved, 3u);
+	EXPECT_EQ(moves, (std::vector<std::pair<size_t, size_t>>{{7, 0}, {6, 2}, {4, 3}}));
+
+	for (size_t idx = 0; idx < 4; ++idx)
+		EXPECT_TRUE(pool.IsInUse(idx));
+	for (size_t idx = 4; idx < 8; ++idx)
+	{
+		EXPECT_FALSE(pool.IsInUse(idx));
+		// vacated slots are reset like after UnUse
+		EXPECT_TRUE(pool[idx]->empty());
+	}
+	for (const auto& [pos, expected] : std::vector<std::pair<size_t, std::string>>{{0, "object 7"}, {1, "object 1"}, {3, "object 4"}})
+	{
+		const auto result = pool.Get(pos);
+		ASSERT_TRUE(result.has_value());
+		EXPECT_EQ(*result.value(), expected);
+	}
+	EXPECT_EQ(pool.ObjectsInUse(), 4u);
+
+	// the next free slot directly follows the prefix
+	size_t idx;
+	const auto result = pool.UseNext(idx);
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(idx, 4u);
+}
+
+TEST(ObjectPool, Compact_RemapTable)
+{
+	auto pool = CObjectPool<CColor, CNoPoolStats, CRecordingObserver>(6);
+	auto result = pool.Use(2);
+	ASSERT_TRUE(result.has_value());
+	result = pool.Use(5);
+	ASSERT_TRUE(result.has_value());
+	result.value()->r = 5;
+
+	const auto remap = pool.Compact();
+	EXPECT_EQ(remap, (std::vector<size_t>{0, 1, 1, 3, 4, 0}));
+	result = pool.Get(0);
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(result.value()->r, 5u);
+	EXPECT_TRUE(pool.IsInUse(1));
+	EXPECT_FALSE(pool.IsInUse(2));
+
+	// nothing to do for an already dense pool, or an empty one
+	EXPECT_EQ(pool.Compact(), (std::vector<size_t>{0, 1, 2, 3, 4, 5}));
+	auto empty = CObjectPool<CColor>(4);
+	EXPECT_EQ(empty.Compact([](size_t, size_t) {}), 0u);
+}
+
+TEST(ObjectPool, Compact_RelocatesHoldTimes)
+{
+	auto pool = CObjectPool<CColor, CNoPoolStats, CHoldTimeObserver<CManualClock>>(4);
+	const auto result = pool.Use(3);
+	ASSERT_TRUE(result.has_value());
+	CManualClock::Advance(std::chrono::nanoseconds(900));
+	const auto remap = pool.Compact();
+	ASSERT_EQ(remap[3], 0u);
+	const auto resultUnuse = pool.UnUse(0);
+	ASSERT_TRUE(resultUnuse.has_value());
+	EXPECT_EQ(pool.Observer().Summary().max, std::chrono::nanoseconds(900));
+}
+
+TEST(ObjectPool, AllocPolicy_LowestFree)
+{
+	auto pool = CObjectPool<CColor, CNoPoolStats, CNoPoolObserver, EAllocPolicy::LOWEST_FREE>(300);
+	size_t idx;
+	for (size_t expected = 0; expected < 300; ++expected)
+	{
+		ASSERT_TRUE(pool.UseNext(idx).has_value());
+		EXPECT_EQ(idx, expected);
+	}
+	EXPECT_EQ(pool.UseNext(idx).error(), EPoolError::FULL);
+
+	for (const size_t pos : {290uz, 70uz, 130uz})
+	{
+		const auto resultUnuse = pool.UnUse(pos);
+		ASSERT_TRUE(resultUnuse.has_value());
+	}
+	for (const size_t expected : {70uz, 130uz, 290uz})
+	{
+		ASSERT_TRUE(pool.UseNext(idx).has_value());
+		EXPECT_EQ(idx, expected);
+	}
+
+	const auto resultUnuse = pool.UnUse(5);
+	ASSERT_TRUE(resultUnuse.has_value());
+	ASSERT_TRUE(pool.Replace(6).has_value());
+	EXPECT_TRUE(pool.UseNextReplace(idx).has_value());
+	EXPECT_EQ(idx, 5u);
+}
+
+TEST(ObjectPool, AllocPolicy_MostRecentlyFreed)
+{
+	auto pool = CObjectPool<CColor, CNoPoolStats, CNoPoolObserver, EAllocPolicy::MOST_RECENTLY_FREED>(10);
+	size_t idx;
+	for (size_t expected = 0; expected < 4; ++expected)
+	{
+		ASSERT_TRUE(pool.UseNext(idx).has_value());
+		EXPECT_EQ(idx, expected);
+	}
+
+	ASSERT_TRUE(pool.UnUse(1).has_value());
+	ASSERT_TRUE(pool.UnUse(3).has_value());
+	ASSERT_TRUE(pool.UseNext(idx).has_value());
+	EXPECT_EQ(idx, 3u);
+	ASSERT_TRUE(pool.UseNext(idx).has_value());
+	EXPECT_EQ(idx, 1u);
+
+	// Use takes slots out of the middle of the free list
+	ASSERT_TRUE(pool.Use(5).has_value());
+	ASSERT_TRUE(pool.Use(4).has_value());
+	for (const size_t expected : {6uz, 7uz, 8uz, 9uz})
+	{
+		ASSERT_TRUE(pool.UseNext(idx).has_value());
+		EXPECT_EQ(idx, expected);
+	}
+	EXPECT_EQ(pool.UseNext(idx).error(), EPoolError::FULL);
+}
+
+// Records every scan length instead of bucketing it
+struct CScanRecordingStats : CNoPoolStats
+{
+	void OnScan(const size_t scanned)
+	{
+		scans.push_back(scanned);
+	}
+
+	std::vector<size_t> scans;
+};
+
+TEST(ObjectPool, Stats_ScanLength_RoundRobin)
+{
+	auto pool = CObjectPool<CColor, CScanRecordingStats>(300);
+	size_t idx;
+	for (size_t count = 0; count < 300; ++count)
+		ASSERT_TRUE(pool.UseNext(idx).has_value());
+	EXPECT_EQ(pool.Stats().scans, std::vector<size_t>(300, 1));
+
+	// the last slot behind `nextIdx`, then from 0 one window of 64 flags and the block found via the summary
+	ASSERT_TRUE(pool.UnUse(150).has_value());
+	ASSERT_TRUE(pool.UseNext(idx).has_value());
+	EXPECT_EQ(idx, 150u);
+	EXPECT_EQ(pool.Stats().scans.back(), 1u + 64u + 23u);
+	// a failed search inspects the window behind `nextIdx` and the one at the start
+	EXPECT_EQ(pool.UseNext(idx).error(), EPoolError::FULL);
+	EXPECT_EQ(pool.Stats().scans.back(), 64u + 64u);
+}
+
+TEST(ObjectPool, Stats_ScanLength_LowestFree)
+{
+	auto pool = CObjectPool<CColor, CScanRecordingStats, CNoPoolObserver, EAllocPolicy::LOWEST_FREE>(300);
+	size_t idx;
+	for (size_t count = 0; count < 300; ++count)
+		ASSERT_TRUE(pool.UseNext(idx).has_value());
+	const auto& scans = pool.Stats().scans;
+	ASSERT_EQ(scans.size(), 300u);
+	EXPECT_EQ(scans[0], 1u);
+	EXPECT_EQ(scans[63], 64u);
+	// the first window is full, the summary skips to the block of the slot
+	EXPECT_EQ(scans[64], 65u);
+	EXPECT_EQ(scans[200], 64u + 9u);
+
+	ASSERT_TRUE(pool.UnUse(150).has_value());
+	ASSERT_TRUE(pool.UseNext(idx).has_value());
+	EXPECT_EQ(idx, 150u);
+	EXPECT_EQ(scans.back(), 64u + 23u);
+	EXPECT_EQ(pool.UseNext(idx).error(), EPoolError::FULL);
+	EXPECT_EQ(scans.back(), 64u);
+}
+
+TEST(ObjectPool, Stats_ScanLength_MostRecentlyFreed)
+{
+	auto pool = CObjectPool<CColor, CPoolStats, CNoPoolObserver, EAllocPolicy::MOST_RECENTLY_FREED>(4);
+	size_t idx;
+	for (size_t count = 0; count < 4; ++count)
+		ASSERT_TRUE(pool.UseNext(idx).has_value());
+	EXPECT_EQ(pool.UseNext(idx).error(), EPoolError::FULL);
+	ASSERT_TRUE(pool.UnUse(2).has_value());
+	ASSERT_TRUE(pool.UseNextReplace(idx).has_value());
+
+	// every pop from the free list inspects one slot, an empty list none
+	const auto& histogram = pool.Stats().ScanHistogram();
+	EXPECT_EQ(histogram.Count(), 6u);
+	EXPECT_EQ(histogram.BucketCount(1), 5u);
+	EXPECT_EQ(histogram.BucketCount(0), 1u);
+}
+
+template <EAllocPolicy ALLOC_POLICY>
+void ExpectConsistentUnderChurn()
+{
+	constexpr size_t POOL_SIZE = 1000;
+	auto pool = CObjectPool<CColor, CNoPoolStats, CNoPoolObserver, ALLOC_POLICY>(POOL_SIZE);
+	std::mt19937 generator(42);
+	std::uniform_int_distribution<size_t> distribution(0, POOL_SIZE - 1);
+	for (int32_t step = 0; step < 20000; ++step)
+	{
+		const size_t pos = distribution(generator);
+		const bool bInUse = pool.IsInUse(pos);
+		switch (step % 3)
+		{
+		case 0:
+			ASSERT_EQ(pool.UnUse(pos).has_value(), bInUse);
+			break;
+		case 1:
+			ASSERT_EQ(pool.Use(pos).has_value(), !bInUse);
+			break;
+		default:
+			{
+				size_t idx;
+				const bool bFull = pool.ObjectsInUse() == POOL_SIZE;
+				const auto result = pool.UseNext(idx);
+				ASSERT_EQ(result.has_value(), !bFull);
+				if (ALLOC_POLICY == EAllocPolicy::LOWEST_FREE && result.has_value())
+				{
+					for (size_t below = 0; below < idx; ++below)
+						ASSERT_TRUE(pool.IsInUse(below));
+				}
+			}
+		}
+	}
+	// compaction keeps the policy structures in sync
+	const auto remap = pool.Compact();
+	ASSERT_EQ(remap.size(), POOL_SIZE);
+	while (pool.ObjectsInUse() < POOL_SIZE)
+	{
+		size_t idx;
+		ASSERT_TRUE(pool.UseNext(idx).has_value());
+	}
+	EXPECT_EQ(static_cast<size_t>(std::ranges::distance(pool)), POOL_SIZE);
+}
+
+TEST(ObjectPool, AllocPolicy_ConsistentUnderChurn)
+{
+	ExpectConsistentUnderChurn<EAllocPolicy::ROUND_ROBIN>();
+	ExpectConsistentUnderChurn<EAllocPolicy::LOWEST_FREE>();
+	ExpectConsistentUnderChurn<EAllocPolicy::MOST_RECENTLY_FREED>();
+}
+
+TEST(ObjectPool, AllocPolicy_Move)
+{
+	auto source = CObjectPool<CColor, CNoPoolStats, CNoPoolObserver, EAllocPolicy::MOST_RECENTLY_FREED>(4);
+	size_t idx;
+	ASSERT_TRUE(source.UseNext(idx).has_value());
+	ASSERT_TRUE(source.UseNext(idx).has_value());
+	ASSERT_TRUE(source.UnUse(0).has_value());
+
+	auto target = std::move(source);
+	ASSERT_TRUE(target.UseNext(idx).has_value());
+	EXPECT_EQ(idx, 0u);
+	EXPECT_EQ(source.UseNext(idx).error(), EPoolError::FULL);
+}
+
+TEST(ObjectPool, BlockSummary_MatchesNaiveSearch)
+{
+	// 300000 blocks need three levels
+	for (const size_t blockCount : {1uz, 63uz, 64uz, 65uz, 4097uz, 300000uz})
+	{
+		Detail::CBlockSummary summary(blockCount);
+		std::vector<bool> naive(blockCount);
+		std::mt19937 generator(static_cast<uint32_t>(blockCount));
+		std::uniform_int_distribution<size_t> distribution(0, blockCount - 1);
+		for (size_t step = 0; step < 2000; ++step)
+		{
+			const size_t block = distribution(generator);
+			if (step % 3 == 2)
+			{
+				summary.Clear(block);
+				naive[block] = false;
+			}
+			else
+			{
+				summary.Set(block);
+				naive[block] = true;
+			}
+			if (step % 50 != 0)
+				continue;
+
+			const size_t from = distribution(generator);
+			size_t expectedFirst = blockCount;
+			for (size_t idx = from; idx < blockCount; ++idx)
+			{
+				if (naive[idx])
+				{
+					expectedFirst = idx;
+					break;
+				}
+			}
+			size_t expectedLast = blockCount;
+			for (size_t idx = from; idx > 0; --idx)
+			{
+				if (naive[idx - 1])
+				{
+					expectedLast = idx - 1;
+					break;
+				}
+			}
+			ASSERT_EQ(summary.FindFirst(from), expectedFirst);
+			ASSERT_EQ(summary.FindLast(from), expectedLast);
+			ASSERT_EQ(summary.Test(block), naive[block]);
+		}
+	}
+}
+
+TEST(ObjectPool, UseNext_NearlyFullHugePool)
+{
+	constexpr size_t POOL_SIZE = 1 << 20;
+	auto pool = CObjectPool<uint8_t, CPoolStats, CNoPoolObserver, EAllocPolicy::LOWEST_FREE>(POOL_SIZE);
+	size_t idx;
+	for (size_t pos = 0; pos < POOL_SIZE; ++pos)
+		ASSERT_TRUE(pool.UseNext(idx).has_value());
+	ASSERT_TRUE(pool.UnUse(POOL_SIZE - 3).has_value());
+	ASSERT_TRUE(pool.UnUse(777777).has_value());
+
+	ASSERT_TRUE(pool.UseNext(idx).has_value());
+	EXPECT_EQ(idx, 777777u);
+	ASSERT_TRUE(pool.UseNext(idx).has_value());
+	EXPECT_EQ(idx, POOL_SIZE - 3);
+
+	// the iterators jump over empty regions in both directions
+	auto sparse = CObjectPool<uint8_t>(POOL_SIZE);
+	ASSERT_TRUE(sparse.Use(5).has_value());
+	ASSERT_TRUE(sparse.Use(POOL_SIZE - 1).has_value());
+	auto it = sparse.begin();
+	EXPECT_EQ(&*it, sparse[5]);
+	EXPECT_EQ(&*++it, sparse[POOL_SIZE - 1]);
+	EXPECT_EQ(&*--it, sparse[5]);
+	EXPECT_EQ(std::ranges::distance(sparse), 2);
+	size_t visited = 0;
+	sparse.ForEachActive([&visited](uint8_t&) { ++visited; });
+	EXPECT_EQ(visited, 2u);
+}
+
+TEST(ObjectPool, UseNear_PicksClosestFreeSlot)
+{
+	auto pool = CObjectPool<CColor, CPoolStats>(300);
+	for (size_t pos = 90; pos < 120; ++pos)
+		ASSERT_TRUE(pool.Use(pos).has_value());
+	ASSERT_TRUE(pool.Use(121).has_value());
+
+	size_t idx = 42;
+	EXPECT_EQ(pool.UseNear(300, idx).error(), EPoolError::OUT_OF_RANGE);
+	ASSERT_TRUE(pool.UseNear(100, idx).has_value());
+	EXPECT_EQ(idx, 89u);
+	// 120 and 122 are equally close, the forward slot wins
+	ASSERT_TRUE(pool.UseNear(121, idx).has_value());
+	EXPECT_EQ(idx, 122u);
+	ASSERT_TRUE(pool.UseNear(121, idx).has_value());
+	EXPECT_EQ(idx, 120u);
+	ASSERT_TRUE(pool.UseNear(5, idx).has_value());
+	EXPECT_EQ(idx, 5u);
+	EXPECT_EQ(pool.ObjectsInUse(), 35u);
+}
+
+template <EAllocPolicy ALLOC_POLICY>
+void ExpectUseNearMatchesNaiveSearch()
+{
+	constexpr size_t POOL_SIZE = 5000;
+	auto pool = CObjectPool<CColor, CPoolStats, CNoPoolObserver, ALLOC_POLICY>(POOL_SIZE);
+	std::mt19937 generator(7);
+	std::uniform_int_distribution<size_t> distribution(0, POOL_SIZE - 1);
+	for (size_t step = 0; step < 20000; ++step)
+	{
+		const size_t hint = distribution(generator);
+		if (step % 4 == 3)
+		{
+			const bool bInUse = pool.IsInUse(hint);
+			ASSERT_EQ(pool.UnUse(hint).has_value(), bInUse);
+			continue;
+		}
+
+		size_t expected = POOL_SIZE;
+		for (size_t distance = 0; distance < POOL_SIZE && expected == POOL_SIZE; ++distance)
+		{
+			if (hint + distance < POOL_SIZE && !pool.IsInUse(hint + distance))
+				expected = hint + distance;
+			else if (distance <= hint && !pool.IsInUse(hint - distance))
+				expected = hint - distance;
+		}
+
+		size_t idx = POOL_SIZE;
+		const auto result = pool.UseNear(hint, idx);
+		if (expected == POOL_SIZE)
+		{
+			EXPECT_EQ(result.error(), EPoolError::FULL);
+			continue;
+		}
+		ASSERT_TRUE(result.has_value());
+		ASSERT_EQ(idx, expected) << "hint " << hint;
+	}
+	EXPECT_GT(pool.Stats().FullFailures(), 0u);
+}
+
+template <EAllocPolicy ALLOC_POLICY>
+void ExpectUseNearTieAtWindowEdge()
+{
+	auto pool = CObjectPool<CColor, CNoPoolStats, CNoPoolObserver, ALLOC_POLICY>(300);
+	size_t idx;
+	for (size_t count = 0; count < 300; ++count)
+		ASSERT_TRUE(pool.UseNext(idx).has_value());
+	// both free slots are exactly one search window (64 slots) away from the hint
+	ASSERT_TRUE(pool.UnUse(36).has_value());
+	ASSERT_TRUE(pool.UnUse(164).has_value());
+
+	ASSERT_TRUE(pool.UseNear(100, idx).has_value());
+	EXPECT_EQ(idx, 164u);
+	ASSERT_TRUE(pool.UseNear(100, idx).has_value());
+	EXPECT_EQ(idx, 36u);
+}
+
+TEST(ObjectPool, UseNear_TieAtWindowEdge)
+{
+	ExpectUseNearTieAtWindowEdge<EAllocPolicy::ROUND_ROBIN>();
+	ExpectUseNearTieAtWindowEdge<EAllocPolicy::LOWEST_FREE>();
+	ExpectUseNearTieAtWindowEdge<EAllocPolicy::MOST_RECENTLY_FREED>();
+}
+
+TEST(ObjectPool, UseNear_MatchesNaiveSearch)
+{
+	ExpectUseNearMatchesNaiveSearch<EAllocPolicy::ROUND_ROBIN>();
+	ExpectUseNearMatchesNaiveSearch<EAllocPolicy::LOWEST_FREE>();
+	ExpectUseNearMatchesNaiveSearch<EAllocPolicy::MOST_RECENTLY_FREED>();
+}
+
+TEST(ObjectPool, UseRange_ClaimsConsecutiveSlots)
+{
+	auto pool = CObjectPool<CColor, CPoolStats>(16);
+	for (const size_t pos : {2uz, 6uz, 9uz})
+		ASSERT_TRUE(pool.Use(pos).has_value());
+
+	size_t idx = 42;
+	EXPECT_EQ(pool.UseRange(0, idx).error(), EPoolError::OUT_OF_RANGE);
+	EXPECT_EQ(pool.UseRange(17, idx).error(), EPoolError::OUT_OF_RANGE);
+	EXPECT_EQ(pool.UseRange(7, idx).error(), EPoolError::FULL);
+	EXPECT_EQ(idx, 42u);
+	EXPECT_EQ(pool.Stats().FullFailures(), 1u);
+
+	// [0, 2) and [3, 6) are too short
+	auto result = pool.UseRange(4, idx);
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(idx, 10u);
+	ASSERT_EQ(result->size(), 4u);
+	EXPECT_EQ(result->data(), pool[10]);
+	for (CColor& color : *result)
+		color.r = 9;
+	for (size_t pos = 10; pos < 14; ++pos)
+	{
+		const auto resultGet = pool.Get(pos);
+		ASSERT_TRUE(resultGet.has_value());
+		EXPECT_EQ(resultGet.value()->r, 9);
+	}
+	EXPECT_FALSE(pool.IsInUse(14));
+	EXPECT_EQ(pool.ObjectsInUse(), 7u);
+
+	ASSERT_TRUE(pool.UseRange(3, idx).has_value());
+	EXPECT_EQ(idx, 3u);
+	EXPECT_EQ(pool.UseRange(3, idx).error(), EPoolError::FULL);
+
+	EXPECT_EQ(pool.UnUseRange(14, 3).error(), EPoolError::OUT_OF_RANGE);
+	EXPECT_EQ(pool.UnUseRange(12, 3).error(), EPoolError::ALREADY_UNUSED);
+	EXPECT_TRUE(pool.IsInUse(12));
+	ASSERT_TRUE(pool.UnUseRange(10, 4).has_value());
+	EXPECT_EQ(pool.ObjectsInUse(), 6u);
+	const auto resultUse = pool.Use(10);
+	ASSERT_TRUE(resultUse.has_value());
+	EXPECT_EQ(resultUse.value()->r, CColor().r);
+}
+
+TEST(ObjectPool, UseRange_MostRecentlyFreed)
+{
+	auto pool = CObjectPool<CColor, CNoPoolStats, CNoPoolObserver, EAllocPolicy::MOST_RECENTLY_FREED>(200);
+	for (size_t pos = 0; pos < 200; pos += 50)
+		ASSERT_TRUE(pool.Use(pos).has_value());
+
+	size_t idx;
+	ASSERT_TRUE(pool.UseRange(49, idx).has_value());
+	EXPECT_EQ(idx, 1u);
+	// the free list must not hand out the claimed slots
+	ASSERT_TRUE(pool.UseNext(idx).has_value());
+	EXPECT_FALSE(idx > 0 && idx < 50);
+	ASSERT_TRUE(pool.UnUseRange(1, 49).has_value());
+	ASSERT_TRUE(pool.UseNext(idx).has_value());
+	EXPECT_EQ(idx, 49u);
+}
+
+TEST(ObjectPool, Snapshot_RestoresObjectsAndOccupancy)
+{
+	auto pool = CObjectPool<CColor>(200);
+	size_t idx;
+	for (size_t count = 0; count < 100; ++count)
+	{
+		auto result = pool.UseNext(idx);
+		ASSERT_TRUE(result.has_value());
+		result.value()->r = static_cast<uint8_t>(count);
+	}
+
+	auto snapshot = pool.Snapshot();
+	EXPECT_EQ(snapshot.Size(), 200u);
+	EXPECT_EQ(snapshot.ObjectsInUse(), 100u);
+
+	ASSERT_TRUE(pool.UnUse(10).has_value());
+	pool[20]->r = 77;
+	ASSERT_TRUE(pool.UseNext(idx).has_value());
+	ASSERT_TRUE(pool.Restore(snapshot).has_value());
+	EXPECT_EQ(pool.ObjectsInUse(), 100u);
+	EXPECT_TRUE(pool.IsInUse(10));
+	auto result = pool.Get(10);
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(result.value()->r, 10);
+	result = pool.Get(20);
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(result.value()->r, 20);
+	EXPECT_FALSE(pool.IsInUse(100));
+	EXPECT_EQ(std::ranges::distance(pool.begin(), pool.end()), 100);
+	// the restored allocation state continues where the snapshot was taken
+	ASSERT_TRUE(pool.UseNext(idx).has_value());
+	EXPECT_EQ(idx, 100u);
+
+	auto other = CObjectPool<CColor>(10);
+	EXPECT_EQ(other.Restore(snapshot).error(), EPoolError::OUT_OF_RANGE);
+	EXPECT_EQ(other.Restore(CObjectPool<CColor>::CSnapshot()).error(), EPoolError::OUT_OF_RANGE);
+
+	auto empty = CObjectPool<CColor>(0);
+	const auto emptySnapshot = empty.Snapshot();
+	EXPECT_TRUE(empty.Restore(emptySnapshot).has_value());
+	const auto restored = empty.RestoreDelta(emptySnapshot);
+	ASSERT_TRUE(restored.has_value());
+	EXPECT_EQ(restored.value(), 0u);
+}
+
+TEST(ObjectPool, Snapshot_DeltaCopiesChangedBlocks)
+{
+	constexpr size_t POOL_SIZE = Detail::BLOCK_SIZE * 4;
+	auto pool = CObjectPool<CColor>(POOL_SIZE);
+	CObjectPool<CColor>::CSnapshot snapshot;
+	EXPECT_EQ(pool.SnapshotDelta(snapshot), POOL_SIZE);
+	EXPECT_EQ(pool.SnapshotDelta(snapshot), 0u);
+
+	auto result = pool.Use(1);
+	ASSERT_TRUE(result.has_value());
+	result.value()->g = 1;
+	result = pool.Use(POOL_SIZE - 1);
+	ASSERT_TRUE(result.has_value());
+	result.value()->g = 2;
+	EXPECT_EQ(pool.SnapshotDelta(snapshot), 2 * Detail::BLOCK_SIZE);
+	EXPECT_EQ(snapshot.ObjectsInUse(), 2u);
+
+	ASSERT_TRUE(pool.UnUse(1).has_value());
+	result = pool.Use(70);
+	ASSERT_TRUE(result.has_value());
+	result.value()->g = 3;
+	auto restored = pool.RestoreDelta(snapshot);
+	ASSERT_TRUE(restored.has_value());
+	EXPECT_EQ(*restored, 2 * Detail::BLOCK_SIZE);
+	result = pool.Get(1);
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(result.value()->g, 1);
+	EXPECT_FALSE(pool.IsInUse(70));
+	EXPECT_EQ(pool[70]->g, CColor().g);
+	EXPECT_EQ(pool.ObjectsInUse(), 2u);
+}
+
+TEST(ObjectPool, Snapshot_DeltaFollowsTrackedWrites)
+{
+	constexpr size_t POOL_SIZE = Detail::BLOCK_SIZE * 4;
+	auto pool = CObjectPool<CColor>(POOL_SIZE);
+	for (size_t pos = 0; pos < POOL_SIZE; pos += Detail::BLOCK_SIZE)
+		ASSERT_TRUE(pool.Use(pos).has_value());
+	auto snapshot = pool.Snapshot();
+
+	// read-only access doesn't mark anything
+	const auto& constPool = pool;
+	const auto resultConst = constPool.Get(0);
+	ASSERT_TRUE(resultConst.has_value());
+	EXPECT_EQ(std::ranges::distance(constPool.begin(), constPool.end()), 4);
+	EXPECT_EQ(pool.SnapshotDelta(snapshot), 0u);
+
+	// a write which restores the old value still counts, the delta follows the accesses
+	auto result = pool.Get(Detail::BLOCK_SIZE);
+	ASSERT_TRUE(result.has_value());
+	result.value()->b = CColor().b;
+	pool[3 * Detail::BLOCK_SIZE + 1]->b = 9;
+	EXPECT_EQ(pool.SnapshotDelta(snapshot), 2 * Detail::BLOCK_SIZE);
+	EXPECT_EQ(pool.SnapshotDelta(snapshot), 0u);
+
+	// mutable iteration marks the blocks with used slots
+	pool.ForEachActive([](CColor& color) { color.r = 1; });
+	EXPECT_EQ(pool.SnapshotDelta(snapshot), POOL_SIZE);
+
+	// a snapshot of another pool with the same capacity is copied completely
+	auto other = CObjectPool<CColor>(POOL_SIZE);
+	EXPECT_EQ(other.SnapshotDelta(snapshot), POOL_SIZE);
+	EXPECT_EQ(snapshot.ObjectsInUse(), 0u);
+	const auto restored = pool.RestoreDelta(snapshot);
+	ASSERT_TRUE(restored.has_value());
+	EXPECT_EQ(restored.value(), POOL_SIZE);
+	EXPECT_EQ(pool.ObjectsInUse(), 0u);
+}
+
+// Mutable accesses from several threads only store the current epoch, run it under TSan to see it is race-free
+TEST(ObjectPool, Snapshot_ConcurrentWritesAreStamped)
+{
+	constexpr size_t POOL_SIZE = Detail::BLOCK_SIZE * 4;
+	auto pool = CObjectPool<uint32_t>(POOL_SIZE);
+	for (size_t pos = 0; pos < POOL_SIZE; ++pos)
+	{
+		auto result = pool.Use(pos);
+		ASSERT_TRUE(result.has_value());
+		*result.value() = static_cast<uint32_t>(pos);
+	}
+	auto snapshot = pool.Snapshot();
+
+	// neighbouring slots of the same blocks, so the threads stamp the same words
+	std::vector<std::thread> writers;
+	for (size_t thread = 0; thread < 4; ++thread)
+	{
+		writers.emplace_back([&pool, thread]
+		{
+			for (size_t pos = thread; pos < 2 * Detail::BLOCK_SIZE; pos += 4)
+			{
+				const auto result = pool.Get(pos);
+				if (result.has_value())
+					*result.value() += 1000;
+			}
+		});
+	}
+	for (auto& writer : writers)
+		writer.join();
+	EXPECT_EQ(pool.SnapshotDelta(snapshot), 2 * Detail::BLOCK_SIZE);
+	EXPECT_EQ(pool.SnapshotDelta(snapshot), 0u);
+
+	// a parallel traversal which writes through `Get` and `operator[]` from the callbacks
+	std::atomic<size_t> visited = 0;
+	pool.ForEachActive(std::execution::par, [&pool, &visited](uint32_t& value)
+	{
+		const size_t pos = value % 1000;
+		const auto result = pool.Get(pos);
+		if (result.has_value() && result.value() == &value)
+			*pool[pos] = static_cast<uint32_t>(pos);
+		visited.fetch_add(1, std::memory_order_relaxed);
+	});
+	EXPECT_EQ(visited.load(), POOL_SIZE);
+	EXPECT_EQ(pool.SnapshotDelta(snapshot), POOL_SIZE);
+	const auto restored = pool.RestoreDelta(snapshot);
+	ASSERT_TRUE(restored.has_value());
+	auto result = pool.Get(1);
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(*result.value(), 1u);
+}
+
+TEST(ObjectPool, Snapshot_RestoreNotifiesPolicies)
+{
+	auto pool = CObjectPool<CColor, CPoolStats, CDirtyObserver>(200);
+	size_t idx;
+	for (size_t count = 0; count < 4; ++count)
+		ASSERT_TRUE(pool.UseNext(idx).has_value());
+	auto snapshot = pool.Snapshot();
+
+	ASSERT_TRUE(pool.UnUse(1).has_value());
+	auto result = pool.Use(150);
+	ASSERT_TRUE(result.has_value());
+	result = pool.Get(2);
+	ASSERT_TRUE(result.has_value());
+	result.value()->r = 5;
+	pool.Observer().ClearDirty();
+
+	auto restored = pool.RestoreDelta(snapshot);
+	ASSERT_TRUE(restored.has_value());
+	EXPECT_EQ(restored.value(), 2 * Detail::BLOCK_SIZE);
+	EXPECT_EQ(pool.Stats().Acquires(), 6u);
+	EXPECT_EQ(pool.Stats().Releases(), 2u);
+	const auto& dirty = pool.Observer();
+	EXPECT_EQ(std::vector<size_t>(dirty.DirtySlots().begin(), dirty.DirtySlots().end()), (std::vector<size_t>{1, 2, 150}));
+
+	// restoring the same state again changes nothing the policies could see
+	pool.Observer().ClearDirty();
+	ASSERT_TRUE(pool.Restore(snapshot).has_value());
+	EXPECT_EQ(pool.Stats().Acquires(), 6u);
+	EXPECT_EQ(pool.Stats().Releases(), 2u);
+	EXPECT_EQ(pool.Observer().DirtyCount(), 0u);
+}
+
+TEST(ObjectPool, Snapshot_MostRecentlyFreed)
+{
+	auto pool = CObjectPool<CColor, CNoPoolStats, CNoPoolObserver, EAllocPolicy::MOST_RECENTLY_FREED>(8);
+	size_t idx;
+	for (size_t count = 0; count < 4; ++count)
+		ASSERT_TRUE(pool.UseNext(idx).has_value());
+	ASSERT_TRUE(pool.UnUse(2).has_value());
+	const auto snapshot = pool.Snapshot();
+
+	ASSERT_TRUE(pool.UnUse(0).has_value());
+	ASSERT_TRUE(pool.Restore(snapshot).has_value());
+	ASSERT_TRUE(pool.UseNext(idx).has_value());
+	EXPECT_EQ(idx, 2u);
+	ASSERT_TRUE(pool.UseNext(idx).has_value());
+	EXPECT_EQ(idx, 4u);
+}
+
+TEST(ObjectPool, DirtyObserver_TracksChangedSlots)
+{
+	auto pool = CObjectPool<CColor, CNoPoolStats, CDirtyObserver>(200);
+	const auto& dirty = pool.Observer();
+	EXPECT_EQ(dirty.DirtyCount(), 0u);
+	EXPECT_EQ(dirty.DirtySlots().begin(), dirty.DirtySlots().end());
+
+	size_t idx;
+	ASSERT_TRUE(pool.UseNext(idx).has_value());
+	ASSERT_TRUE(pool.Use(70).has_value());
+	ASSERT_TRUE(pool.Use(199).has_value());
+	EXPECT_EQ(std::vector<size_t>(dirty.DirtySlots().begin(), dirty.DirtySlots().end()), (std::vector<size_t>{0, 70, 199}));
+
+	pool.Observer().ClearDirty();
+	EXPECT_EQ(dirty.DirtyCount(), 0u);
+	// const access doesn't count as a change
+	EXPECT_TRUE(std::as_const(pool).Get(70).has_value());
+	EXPECT_FALSE(dirty.IsDirty(70));
+	const auto result = pool.Get(70);
+	ASSERT_TRUE(result.has_value());
+	result.value()->r = 1;
+	ASSERT_TRUE(pool.UnUse(0).has_value());
+	ASSERT_TRUE(pool.Replace(5).has_value());
+	pool[130]->g = 2;
+	pool.Observer().MarkDirty(130);
+	EXPECT_EQ(std::vector<size_t>(dirty.DirtySlots().begin(), dirty.DirtySlots().end()), (std::vector<size_t>{0, 5, 70, 130}));
+	EXPECT_EQ(dirty.DirtyCount(), 4u);
+
+	pool.Observer().ClearDirty();
+	EXPECT_EQ(pool.Compact([](size_t, size_t) {}), 2u);
+	EXPECT_TRUE(dirty.IsDirty(199));
+	EXPECT_TRUE(dirty.IsDirty(0));
+	EXPECT_EQ(dirty.DirtyCount(), 4u);
+}
+
+TEST(ObjectPool, ExternalBuffer_LaysSlotsOutInBuffer)
+{
+	alignas(CColor) std::array<std::byte, CObjectPool<CColor>::BufferSize(10)> buffer{};
+	auto pool = CObjectPool<CColor>(std::span<std::byte>(buffer));
+	EXPECT_EQ(pool.Size(), 10u);
+	EXPECT_EQ(static_cast<void*>(pool[0]), static_cast<void*>(buffer.data()));
+	EXPECT_EQ(pool[9]->r, 255);
+
+	size_t idx;
+	for (size_t count = 0; count < 10; ++count)
+	{
+		auto result = pool.UseNext(idx);
+		ASSERT_TRUE(result.has_value());
+		result.value()->g = static_cast<uint8_t>(count);
+	}
+	EXPECT_EQ(pool.UseNext(idx).error(), EPoolError::FULL);
+	EXPECT_EQ(std::to_integer<uint8_t>(buffer[sizeof(CColor) * 3 + 1]), 3);
+
+	// moving hands over the buffer, the objects stay in place
+	auto target = CObjectPool<CColor>(std::move(pool));
+	EXPECT_EQ(target.Size(), 10u);
+	EXPECT_EQ(static_cast<void*>(target[0]), static_cast<void*>(buffer.data()));
+	EXPECT_EQ(pool.Size(), 0u);
+	EXPECT_EQ(std::ranges::distance(target.begin(), target.end()), 10);
+}
+
+TEST(ObjectPool, ExternalBuffer_AlignsAndDestroysObjects)
+{
+	struct alignas(16) CTracked
+	{
+		int32_t* pDestroyed = nullptr;
+		~CTracked()
+		{
+			if (pDestroyed != nullptr)
+				++*pDestroyed;
+		}
+	};
+
+	int32_t destroyed = 0;
+	alignas(16) std::array<std::byte, 16 * 5> buffer{};
+	const std::span<std::byte> memory(buffer);
+	{
+		// starting one byte in, only four aligned slots fit
+		auto pool = CObjectPool<CTracked>(memory.subspan(1), CTracked{&destroyed});
+		destroyed = 0; // the temporary argument
+		EXPECT_EQ(pool.Size(), 4u);
+		EXPECT_EQ(static_cast<void*>(pool[0]), static_cast<void*>(buffer.data() + 16));
+		ASSERT_TRUE(pool.Use(2).has_value());
+	}
+	EXPECT_EQ(destroyed, 4);
+
+	auto tooSmall = CObjectPool<CTracked>(memory.subspan(1, 16));
+	EXPECT_EQ(tooSmall.Size(), 0u);
+	size_t idx;
+	EXPECT_EQ(tooSmall.UseNext(idx).error(), EPoolError::FULL);
+}
 }
@@ -0,0 +1,224 @@
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <gtest/gtest.h>
+
+#include "../include/CSharedObjectPool.hpp"
+
+using namespace ObjectPool;
+
+namespace Tests::SharedObjectPool
+{
+struct CMessage
+{
+	uint64_t sequence = 0;
+	uint32_t owner = 0;
+	char payload[20] = {};
+};
+
+// Unique segment name per test, unlinked at the end of the test
+class SharedObjectPool : public testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		name = std::string("/object_pool_") + testing::UnitTest::GetInstance()->current_test_info()->name()
+			+ "_" + std::to_string(::getpid());
+	}
+
+	void TearDown() override
+	{
+		(void)CSharedObjectPool<CMessage>::Unlink(name);
+	}
+
+	std::string name;
+};
+
+TEST_F(SharedObjectPool, HandsObjectsToOtherProcess)
+{
+	auto pool = CSharedObjectPool<CMessage>::Create(name, 16);
+	ASSERT_TRUE(pool.has_value());
+	int toChild[2];
+	int toParent[2];
+	ASSERT_EQ(::pipe(toChild), 0);
+	ASSERT_EQ(::pipe(toParent), 0);
+
+	const pid_t child = ::fork();
+	ASSERT_GE(child, 0);
+	if (child == 0)
+	{
+		// consumer: maps the segment by name, reads the object in place and releases it
+		auto consumer = CSharedObjectPool<CMessage>::Open(name);
+		size_t idx = 0;
+		bool bOk = consumer.has_value() && ::read(toChild[0], &idx, sizeof(idx)) == sizeof(idx);
+		const auto message = bOk ? consumer->Get(idx) : std::unexpected(EPoolError::NOT_IN_USE);
+		bOk = bOk && message.has_value() && message.value()->sequence == 42;
+		bOk = bOk && consumer->UnUse(idx).has_value();
+		const uint8_t result = bOk ? 1 : 0;
+		(void)!::write(toParent[1], &result, sizeof(result));
+		::_exit(0);
+	}
+
+	size_t idx;
+	auto result = pool->UseNext(idx);
+	ASSERT_TRUE(result.has_value());
+	(*result)->sequence = 42;
+	ASSERT_EQ(::write(toChild[1], &idx, sizeof(idx)), static_cast<ssize_t>(sizeof(idx)));
+
+	uint8_t bConsumed = 0;
+	ASSERT_EQ(::read(toParent[0], &bConsumed, sizeof(bConsumed)), 1);
+	int status = 0;
+	::waitpid(child, &status, 0);
+	EXPECT_EQ(bConsumed, 1);
+	EXPECT_FALSE(pool->IsInUse(idx));
+	EXPECT_EQ(pool->ObjectsInUse(), 0u);
+	// the next owner receives a reset object
+	result = pool->Use(idx);
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(result.value()->sequence, 0u);
+	for (const int fd : {toChild[0], toChild[1], toParent[0], toParent[1]})
+		::close(fd);
+}
+
+TEST_F(SharedObjectPool, CapacityNotMultipleOfWord)
+{
+	auto pool = CSharedObjectPool<CMessage>::Create(name, 70);
+	ASSERT_TRUE(pool.has_value());
+	size_t idx;
+	for (size_t count = 0; count < 70; ++count)
+		ASSERT_TRUE(pool->UseNext(idx).has_value());
+	EXPECT_EQ(pool->UseNext(idx).error(), EPoolError::FULL);
+	EXPECT_EQ(pool->Use(70).error(), EPoolError::OUT_OF_RANGE);
+	EXPECT_EQ(pool->Use(69).error(), EPoolError::ALREADY_IN_USE);
+	ASSERT_TRUE(pool->UnUse(65).has_value());
+	EXPECT_EQ(pool->UnUse(65).error(), EPoolError::ALREADY_UNUSED);
+	EXPECT_EQ(pool->Get(65).error(), EPoolError::NOT_IN_USE);
+	ASSERT_TRUE(pool->UseNext(idx).has_value());
+	EXPECT_EQ(idx, 65u);
+	EXPECT_EQ(pool->ObjectsInUse(), 70u);
+}
+
+TEST_F(SharedObjectPool, OpenValidatesSegment)
+{
+	EXPECT_EQ(CSharedObjectPool<CMessage>::Open(name).error(), EMappedPoolError::OPEN_FAILED);
+	ASSERT_TRUE(CSharedObjectPool<CMessage>::Create(name, 8).has_value());
+	EXPECT_EQ(CSharedObjectPool<CMessage>::Create(name, 8).error(), EMappedPoolError::OPEN_FAILED);
+	EXPECT_EQ(CSharedObjectPool<uint64_t>::Open(name).error(), EMappedPoolError::TYPE_MISMATCH);
+	auto pool = CSharedObjectPool<CMessage>::Open(name);
+	ASSERT_TRUE(pool.has_value());
+	EXPECT_EQ(pool->Size(), 8u);
+
+	EXPECT_TRUE(CSharedObjectPool<CMessage>::Unlink(name));
+	EXPECT_FALSE(CSharedObjectPool<CMessage>::Unlink(name));
+	// the mapping stays valid after unlinking
+	EXPECT_TRUE(pool->Use(3).has_value());
+}
+
+// Two handles on the same segment behave like two processes
+TEST_F(SharedObjectPool, ConcurrentUnUseReleasesOnce)
+{
+	auto pool = CSharedObjectPool<CMessage>::Create(name, 1);
+	ASSERT_TRUE(pool.has_value());
+	for (int32_t round = 0; round < 1000; ++round)
+	{
+		auto result = pool->Use(0);
+		ASSERT_TRUE(result.has_value());
+		result.value()->sequence = 7;
+
+		std::atomic<int32_t> released = 0;
+		std::vector<std::thread> releasers;
+		for (int32_t thread = 0; thread < 2; ++thread)
+		{
+			releasers.emplace_back([&]
+			{
+				if (pool->UnUse(0).has_value())
+					released.fetch_add(1);
+			});
+		}
+		for (auto& releaser : releasers)
+			releaser.join();
+		ASSERT_EQ(released.load(), 1);
+		ASSERT_EQ(pool->ObjectsInUse(), 0u);
+	}
+	const auto result = pool->Use(0);
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(result.value()->sequence, 0u);
+}
+
+TEST_F(SharedObjectPool, MovedFromPoolIsEmpty)
+{
+	auto pool = CSharedObjectPool<CMessage>::Create(name, 16);
+	ASSERT_TRUE(pool.has_value());
+	ASSERT_TRUE(pool->Use(3).has_value());
+
+	auto target = std::move(*pool);
+	EXPECT_EQ(target.Size(), 16u);
+	EXPECT_EQ(target.ObjectsInUse(), 1u);
+	EXPECT_EQ(pool->Size(), 0u);
+	EXPECT_EQ(pool->ObjectsInUse(), 0u);
+	EXPECT_FALSE(pool->IsInUse(3));
+	EXPECT_EQ(pool->Use(0).error(), EPoolError::OUT_OF_RANGE);
+	EXPECT_EQ(pool->Get(3).error(), EPoolError::OUT_OF_RANGE);
+	EXPECT_EQ(pool->UnUse(3).error(), EPoolError::OUT_OF_RANGE);
+	size_t idx;
+	EXPECT_EQ(pool->UseNext(idx).error(), EPoolError::FULL);
+
+	// assigning back swaps the mappings
+	*pool = std::move(target);
+	EXPECT_EQ(pool->Size(), 16u);
+	EXPECT_TRUE(pool->IsInUse(3));
+	EXPECT_EQ(target.Size(), 0u);
+	EXPECT_EQ(target.ObjectsInUse(), 0u);
+}
+
+TEST_F(SharedObjectPool, ConcurrentUseNextNeverSharesSlots)
+{
+	constexpr size_t POOL_SIZE = 200;
+	constexpr uint32_t THREADS = 4;
+	constexpr size_t ROUNDS = 20000;
+	auto creator = CSharedObjectPool<CMessage>::Create(name, POOL_SIZE);
+	ASSERT_TRUE(creator.has_value());
+	std::atomic<size_t> conflicts = 0;
+
+	std::vector<std::thread> workers;
+	for (uint32_t thread = 1; thread <= THREADS; ++thread)
+	{
+		workers.emplace_back([&, thread]
+		{
+			auto pool = CSharedObjectPool<CMessage>::Open(name);
+			ASSERT_TRUE(pool.has_value());
+			std::vector<size_t> held;
+			for (size_t round = 0; round < ROUNDS; ++round)
+			{
+				size_t idx;
+				if (auto result = pool->UseNext(idx); result.has_value())
+				{
+					if ((*result)->owner != 0)
+						conflicts.fetch_add(1);
+					(*result)->owner = thread;
+					held.push_back(idx);
+				}
+				if (held.size() > POOL_SIZE / THREADS / 2 || round + 1 == ROUNDS)
+				{
+					for (const size_t pos : held)
+					{
+						if ((*pool)[pos]->owner != thread)
+							conflicts.fetch_add(1);
+						ASSERT_TRUE(pool->UnUse(pos).has_value());
+					}
+					held.clear();
+				}
+			}
+		});
+	}
+	for (auto& worker : workers)
+		worker.join();
+
+	EXPECT_EQ(conflicts.load(), 0u);
+	EXPECT_EQ(creator->ObjectsInUse(), 0u);
+}
+}